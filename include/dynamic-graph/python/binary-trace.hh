@@ -0,0 +1,73 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_BINARY_TRACE_HH
+#define DYNAMIC_GRAPH_PYTHON_BINARY_TRACE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "dynamic-graph/python/api.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Format of the binary trace files written by TracerRealTimeBinary and
+/// read by dynamic_graph.binary_trace.
+///
+/// A file starts with a header
+/// - char magic[8] = "DGTRACE1",
+/// - uint32 header size, a multiple of 8,
+/// - uint32 number of doubles of a record,
+/// - uint32 dimension of the value, 0 for a scalar and 1 for a vector,
+/// - uint32 size of the name of the signal, followed by the name,
+/// followed by records made of an int64 time and the doubles of the value,
+/// in the byte order of the machine.
+namespace binaryTrace {
+
+struct Header {
+  /// Size in bytes, a multiple of 8.
+  std::uint32_t size;
+  /// Number of doubles of a record.
+  std::uint32_t width;
+  /// 0 for a scalar and 1 for a vector.
+  std::uint32_t dimension;
+  std::string name;
+};
+
+/// Header of the records of a signal.
+/// \param cols size of the vectors, or 0 for scalars.
+DYNAMIC_GRAPH_PYTHON_DLLAPI Header makeHeader(const std::string& name,
+                                              std::size_t cols);
+
+/// Size in bytes of a record.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::size_t recordSize(const Header& header);
+
+/// Write the header.size bytes of header to data.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void writeHeader(const Header& header,
+                                             char* data);
+
+/// Read a header from the size bytes at data.
+/// \return false if they do not start with a complete header.
+DYNAMIC_GRAPH_PYTHON_DLLAPI bool readHeader(const char* data, std::size_t size,
+                                            Header& header);
+
+/// Write the time of the record at data.
+/// \return the address of its values, aligned if data is.
+DYNAMIC_GRAPH_PYTHON_DLLAPI double* writeRecord(char* data,
+                                                std::int64_t time);
+
+/// Read the time of the record at data.
+/// \return the address of its values.
+DYNAMIC_GRAPH_PYTHON_DLLAPI const double* readRecord(const char* data,
+                                                     std::int64_t& time);
+
+}  // namespace binaryTrace
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_BINARY_TRACE_HH
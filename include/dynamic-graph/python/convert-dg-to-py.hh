@@ -4,6 +4,9 @@
 #include <dynamic-graph/value.h>
 
 #include <boost/python.hpp>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace dynamicgraph {
 namespace python {
@@ -13,6 +16,38 @@ command::Value toValue(boost::python::object o,
                        const command::Value::Type& type);
 boost::python::object fromValue(const command::Value& value);
 
+/// Converter from a Python object to a command::Value of a given type.
+/// The converted value is constructed in place at the end of \c values.
+typedef void (*ValueAppender)(std::vector<command::Value>& values,
+                              PyObject* o);
+
+/// Return the converter for arguments of type \c type.
+ValueAppender valueAppender(const command::Value::Type& type);
+
+/// Return a numpy array of \c rows rows of \c cols zeros, contiguous in C
+/// order, or a one dimensional array of \c rows zeros if \c cols is 0.
+/// \param data receives the address of the first element.
+boost::python::object newArray(Py_ssize_t rows, Py_ssize_t cols,
+                               double** data);
+
+/// Return a numpy array viewing \c rows rows of \c cols doubles at \c data,
+/// in C order, or \c rows doubles if \c cols is 0.
+/// \param owner keeps the memory alive as long as the array.
+boost::python::object viewArray(double* data, Py_ssize_t rows,
+                                Py_ssize_t cols,
+                                const std::shared_ptr<void>& owner);
+
+/// Read the text of a vector "[n](x_1,...,x_n)" or of a matrix
+/// "[n,m]((x_11,...,x_1m),...,(x_n1,...,x_nm))", as written by the signals,
+/// into a numpy array of one or two dimensions, without loss of precision.
+/// \throw std::invalid_argument if the text is not in this format.
+boost::python::object stringToArray(const std::string& text);
+
+/// Write a number, or a sequence or array of one or two dimensions, in the
+/// format read by stringToArray. The numbers are written with the fewest
+/// digits that read back to the same doubles.
+std::string arrayToString(boost::python::object o);
+
 }  // namespace convert
 }  // namespace python
 }  // namespace dynamicgraph
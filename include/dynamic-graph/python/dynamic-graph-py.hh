@@ -48,9 +48,15 @@ namespace entity {
 /// \param obj an Entity object
 void addCommands(boost::python::object obj);
 void addSignals(boost::python::object obj);
+/// Implementation of Entity.__getattr__ and Entity.__dir__
+bp::object getAttr(bp::object obj, const std::string& name);
+bp::list dir(bp::object obj);
 
+/// Called without the GIL and with the graph locked, see ScopedGraphCall.
 Entity* create(const char* type, const char* name);
 bp::object executeCmd(bp::tuple args, bp::dict);
+/// Implementation of Command.__call__ with the METH_FASTCALL convention.
+PyObject* callCmd(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
 }  // namespace entity
 
 namespace factory {
@@ -60,14 +66,79 @@ namespace pool {
 void writeGraph(const char* filename);
 bp::list getEntityList();
 const std::map<std::string, Entity*>* getEntityMap();
+/// Names, entities and pairs (name, entity) of the pool, cached until the
+/// pool changes.
+bp::tuple entityNames();
+bp::tuple entities();
+bp::tuple items();
+/// Access to the map of the pool under poolMutex, see signal-handle.hh.
+std::size_t size();
+bool hasEntity(const std::string& name);
+/// \throw std::out_of_range if there is no such entity.
+Entity* getEntity(const std::string& name);
+/// Register an entity under a name, unless the name is taken.
+void addEntity(const std::string& name, Entity* entity);
+/// Counter incremented by invalidate(). The bindings call it each time they
+/// add an entity, with poolMutex locked exclusive, or register or remove a
+/// signal, so that the views of the pool and the handles are resolved again.
+/// The changes made from C++ without the bindings need a call to invalidate.
+std::size_t version();
+void invalidate();
+bp::list createEntities(bp::object entities);
+bp::list plugMany(bp::object plugs);
+/// \param o either a signal or a path "entity.signal"
+SignalBase<int>* toSignal(PyObject* o);
+void saveState(const std::string& filename);
+bp::list loadState(const std::string& filename);
 }  // namespace pool
+namespace graph {
+bp::list run(bp::object outputs, int t0, int nSteps, bp::object record,
+             bp::object out, int threads);
+/// Same as run, setting before each time the values of an input log.
+bp::list replay(const std::string& filename, bp::object outputs, int t0,
+                int nSteps, bp::object record, bp::object out, int threads);
+/// Groups of indices of outputs whose dependency cones are disjoint.
+bp::list cones(bp::object outputs);
+bp::dict dependencyGraph();
+}  // namespace graph
+namespace monitor {
+/// \param signal either a signal or a path "entity.signal"
+/// \return the identifier of the watch
+std::size_t watch(bp::object signal, bp::object callback, double tolerance);
+void unwatch(std::size_t id);
+void start(double period);
+void stop();
+bp::dict stats();
+}  // namespace monitor
+namespace aio {
+/// \return a file descriptor readable once waits are over, to be read by
+///         ready.
+int fd();
+/// Wait until a signal, given as an object or a path "entity.signal", is
+/// computed at time or later.
+/// \return the identifier of the wait
+std::size_t waitTime(bp::object signal, int time);
+void cancel(std::size_t id);
+/// \return the identifiers of the waits over since the last call.
+bp::list ready();
+void setPeriod(double period);
+}  // namespace aio
 namespace debug {
 void addLoggerFileOutputStream(const char* filename);
 void addLoggerCoutOutputStream();
 void closeLoggerFileOutputStream();
+void addLoggerBinaryOutputStream(const char* prefix, std::size_t segmentSize);
+void closeLoggerBinaryOutputStream();
+void addLoggerPythonOutputStream(bp::object callback, std::size_t batchSize,
+                                 double period);
+void closeLoggerPythonOutputStream();
 void realTimeLoggerSpinOnce();
 void realTimeLoggerDestroy();
 void realTimeLoggerInstance();
+void realTimeLoggerStartSpinner(std::size_t batchSize, double period,
+                                bp::object cpus);
+void realTimeLoggerStopSpinner();
+bp::dict realTimeLoggerStats();
 }  // namespace debug
 
 }  // namespace python
@@ -0,0 +1,107 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_GIL_HH
+#define DYNAMIC_GRAPH_PYTHON_GIL_HH
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "dynamic-graph/python/api.hh"
+#include "dynamic-graph/python/python-compat.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Release the GIL, held by the current thread, for the lifetime of the
+/// object.
+class ScopedGILRelease {
+ public:
+  ScopedGILRelease() : state_(PyEval_SaveThread()) {}
+  ~ScopedGILRelease() { PyEval_RestoreThread(state_); }
+
+ private:
+  ScopedGILRelease(const ScopedGILRelease&);
+  ScopedGILRelease& operator=(const ScopedGILRelease&);
+
+  PyThreadState* state_;
+};
+
+/// Acquire the GIL, from any thread, for the lifetime of the object.
+class ScopedGILEnsure {
+ public:
+  ScopedGILEnsure() : state_(PyGILState_Ensure()) {}
+  ~ScopedGILEnsure() { PyGILState_Release(state_); }
+
+ private:
+  ScopedGILEnsure(const ScopedGILEnsure&);
+  ScopedGILEnsure& operator=(const ScopedGILEnsure&);
+
+  PyGILState_STATE state_;
+};
+
+/// Mutex serializing the accesses of the bindings to the graph: the
+/// computations they run without the GIL, and the reads and writes of the
+/// values, times and plugs of the signals and the creation of entities.
+///
+/// To avoid dead locks, a thread never waits for this mutex while holding the
+/// GIL. It may wait for the GIL while holding the mutex, which is what a
+/// signal computed by Python code does.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::recursive_mutex& graphMutex();
+
+/// Release the GIL and lock the graph for the lifetime of the object, around
+/// C++ computations that do not touch Python objects.
+class ScopedGraphCall {
+ public:
+  ScopedGraphCall() : lock_(graphMutex()) {}
+
+ private:
+  ScopedGILRelease release_;
+  std::lock_guard<std::recursive_mutex> lock_;
+};
+
+/// Lock the graph for a short access, such as reading or writing the value
+/// of a signal, from a thread holding the GIL. The GIL is kept when the graph
+/// is free, so that the access does not wait for the GIL again, and released
+/// only while waiting for the graph.
+class DYNAMIC_GRAPH_PYTHON_DLLAPI ScopedGraphAccess {
+ public:
+  ScopedGraphAccess();
+  ~ScopedGraphAccess() { graphMutex().unlock(); }
+
+ private:
+  ScopedGraphAccess(const ScopedGraphAccess&);
+  ScopedGraphAccess& operator=(const ScopedGraphAccess&);
+};
+
+/// Unlock the graph for a while if a ScopedGraphAccess waits for it. Called
+/// between the steps of long computations, such as run, by the thread
+/// locking the graph.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void yieldGraph();
+
+/// Python error kept in a C++ exception, so that it crosses the threads
+/// without the GIL, such as the workers of run, and is raised again in
+/// Python by the translator registered by the bindings.
+class DYNAMIC_GRAPH_PYTHON_DLLAPI PythonError : public std::runtime_error {
+ public:
+  /// Take the error indicator of the current thread, which holds the GIL.
+  PythonError();
+
+  /// Set the error indicator of the current thread, which holds the GIL.
+  void restore() const;
+
+ private:
+  struct Error;
+  explicit PythonError(const std::shared_ptr<Error>& error);
+
+  std::shared_ptr<Error> error_;
+};
+
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_GIL_HH
@@ -0,0 +1,64 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_INPUT_LOG_HH
+#define DYNAMIC_GRAPH_PYTHON_INPUT_LOG_HH
+
+#include <dynamic-graph/signal-base.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "dynamic-graph/python/api.hh"
+#include "dynamic-graph/python/value-file.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Log of the values set to the signals through the bindings, replayed by
+/// graph::replay.
+///
+/// A value is written with the time of the first step it can change: one
+/// after the last time recomputed through the bindings, by recompute or
+/// run. A log starts with the magic "DGINPUT1", followed by the values, as
+/// an int64 time, the string path "entity.signal" and the value (see
+/// valueFile).
+namespace inputLog {
+
+/// Write the values set from now on to filename.
+/// \param time time of the values set before the next recomputation.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void start(const std::string& filename,
+                                       int time);
+
+/// Close the log.
+/// \return the number of values written.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::size_t stop();
+
+/// Write the constant value of signal, if a log is open. The values of the
+/// signals of no entity of the pool are not written, since they could not
+/// be replayed.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void record(SignalBase<int>& signal);
+
+/// Called once the graph was recomputed at time t.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void advance(int t);
+
+struct Input {
+  int time;
+  std::string path;
+  valueFile::Setter set;
+};
+
+/// Read the values of a log, sorted by time.
+/// \throw std::runtime_error if file is not a log.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::vector<Input> read(
+    valueFile::MappedFile& file);
+
+}  // namespace inputLog
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_INPUT_LOG_HH
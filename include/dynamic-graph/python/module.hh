@@ -7,11 +7,16 @@
 #endif
 
 #include <dynamic-graph/entity.h>
+#include <dynamic-graph/pool.h>
 
 #include <boost/mpl/for_each.hpp>
 #include <boost/mpl/vector.hpp>
 #include <boost/python.hpp>
 #include <dynamic-graph/python/dynamic-graph-py.hh>
+#include <dynamic-graph/python/gil.hh>
+#include <dynamic-graph/python/signal-handle.hh>
+#include <shared_mutex>
+#include <string>
 
 namespace dynamicgraph {
 namespace python {
@@ -21,28 +26,86 @@ constexpr int AddCommands = 2;
 
 namespace internal {
 
-template <typename T, int Options = AddCommands | AddSignals>
-bp::object makeEntity1(const char* name) {
-  Entity* ent = entity::create(T::CLASS_NAME.c_str(), name);
+/// Entity of the pool named name, created by the factory if there is none.
+template <typename T>
+T* createEntity(const char* name) {
+  Entity* ent;
+  {
+    ScopedGraphCall graphCall;
+    ent = entity::create(T::CLASS_NAME.c_str(), name);
+  }
   assert(dynamic_cast<T*>(ent) != NULL);
-  bp::object obj(bp::ptr(static_cast<T*>(ent)));
-  if (Options & AddCommands) entity::addCommands(obj);
-  if (Options & AddSignals) entity::addSignals(obj);
-  return obj;
+  return static_cast<T*>(ent);
 }
-template <typename T, int Options = AddCommands | AddSignals>
+
+template <typename T>
+bp::object makeEntity1(const char* name) {
+  // Commands and signals are resolved on access by Entity.__getattr__.
+  return bp::object(bp::ptr(createEntity<T>(name)));
+}
+template <typename T>
 bp::object makeEntity2() {
-  return makeEntity1<T, Options>("");
+  return makeEntity1<T>("");
+}
+
+/// Reference to an entity owned by the pool, held by the Python objects
+/// created by calling the class of the entity. The entity is looked up again
+/// by name once the version of the pool changed, so that an entity no longer
+/// in the pool is not accessed: the object then designates no entity, and
+/// cannot be passed to the bindings.
+template <typename T>
+class EntityRef {
+ public:
+  typedef T element_type;
+
+  explicit EntityRef(T* entity)
+      : name_(entity->getName()), entity_(entity), version_(pool::version()) {}
+
+  /// Called with the GIL.
+  T* get() const {
+    const std::size_t current = pool::version();
+    if (version_ != current) {
+      Entity* entity = NULL;
+      {
+        std::shared_lock<std::shared_timed_mutex> read(pool::poolMutex());
+        PoolStorage::getInstance()->existEntity(name_, entity);
+      }
+      entity_ = dynamic_cast<T*>(entity);
+      version_ = current;
+    }
+    return entity_;
+  }
+
+ private:
+  std::string name_;
+  mutable T* entity_;
+  mutable std::size_t version_;
+};
+
+/// Used by boost::python to access the entity of the holder.
+template <typename T>
+T* get_pointer(const EntityRef<T>& ref) {
+  return ref.get();
+}
+
+/// Constructor of the Python class.
+template <typename T>
+EntityRef<T> construct(const std::string& name) {
+  return EntityRef<T>(createEntity<T>(name.c_str()));
 }
 
 }  // namespace internal
 
-/// \tparam Options by default, all the signals and commands are added as
-///         attribute to the Python object. This behaviour works fine for
-///         entities that have static commands and signals.
-///         If some commands or signals are added or removed dynamiccally, then
-///         it is better to disable the default behaviour and handle it
-///         specifically.
+/// \tparam Options with AddSignals, respectively AddCommands, the signals,
+///         respectively the commands, are resolved by Entity.__getattr__
+///         when accessed as attributes of the Python object, including those
+///         added or removed dynamically. Without, they are only bound by the
+///         methods add_signals and add_commands.
+///
+/// Since __getattr__ is only called when the regular lookup fails, the
+/// methods and attributes of the Python class take precedence over the
+/// commands and signals of the same name. Before, the commands were bound at
+/// construction and hid the methods: add_commands binds them this way.
 template <typename T,
           typename bases = boost::python::bases<dynamicgraph::Entity>,
           int Options = AddCommands | AddSignals>
@@ -50,33 +113,14 @@ inline auto exposeEntity() {
   // std::string hiddenClassName ("_" + T::CLASS_NAME);
   std::string hiddenClassName(T::CLASS_NAME);
   namespace bp = boost::python;
+  // The entities are created by the factory, as entity::create does, even
+  // when the class is called instead of the function of the same name.
   bp::class_<T, bases, boost::noncopyable> obj(hiddenClassName.c_str(),
-                                               bp::init<std::string>());
-  /* TODO at the moment, I couldn't easily find a way to define a Python
-  constructor
-   * that would create the entity via the factory and then populate the
-   * python object with its commands.
-   * This is achieved with a factory function of the same name.
-  obj.def ("__init__", bp::raw_function(+[](bp::object args, bp::dict) {
-          if (bp::len(args) != 2)
-            throw std::length_error("Expected 2 arguments.");
-          bp::object self = args[0];
-          self.attr("__init__")(bp::extract<std::string>(args[1]));
-          Entity* ent = entity::create(T::CLASS_NAME.c_str(), name);
-          if (dynamic_cast<T*>(ent) == NULL)
-            std::cout << "foo" << std::endl;
-          assert(dynamic_cast<T*>(ent) != NULL);
-          self = bp::object(bp::ptr(static_cast<T*>(ent)));
-          //dynamicgraph::Entity& unused =
-  bp::extract<dynamicgraph::Entity&>(self);
-          //entity::addCommands(self);
-        })
-  ;
-  */
-  bp::def(T::CLASS_NAME.c_str(), &internal::makeEntity1<T, Options>);
-  bp::def(T::CLASS_NAME.c_str(), &internal::makeEntity2<T, Options>);
-  if (!(Options & AddCommands)) obj.def("add_commands", &entity::addCommands);
-  if (!(Options & AddSignals)) obj.def("add_signals", &entity::addSignals);
+                                               bp::no_init);
+  obj.def("__init__", bp::make_constructor(&internal::construct<T>));
+  bp::def(T::CLASS_NAME.c_str(), &internal::makeEntity1<T>);
+  bp::def(T::CLASS_NAME.c_str(), &internal::makeEntity2<T>);
+  obj.setattr("_attribute_options", Options);
   return obj;
 }
 
@@ -0,0 +1,50 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_RECORDER_HH
+#define DYNAMIC_GRAPH_PYTHON_RECORDER_HH
+
+#include <dynamic-graph/linear-algebra.h>
+#include <dynamic-graph/signal-base.h>
+
+#include <memory>
+
+#include "dynamic-graph/python/api.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Copy of the value of a signal into a row of an array of doubles.
+class DYNAMIC_GRAPH_PYTHON_DLLAPI Recorder {
+ public:
+  virtual ~Recorder() {}
+
+  /// Whether the values are vectors, written to rows of a two dimensional
+  /// array, instead of scalars. Known without computing the signal.
+  virtual bool vector() const = 0;
+  /// Number of columns of the array, from the value at time t, or 0 for a
+  /// one dimensional array of scalars.
+  virtual Eigen::Index columns(int t) = 0;
+  /// Write the value at time t to row.
+  /// \throw std::length_error if the size of a vector changed since columns.
+  virtual void read(int t, double* row) = 0;
+
+  /// Same as columns, from the value last computed, without recomputing it.
+  virtual Eigen::Index cachedColumns() = 0;
+  /// Same as read, from the value last computed, without recomputing it.
+  virtual void readCached(double* row) = 0;
+};
+
+/// \return a recorder of signal, which may recompute it
+/// \throw std::invalid_argument if the type of the signal is not double,
+///        float, int, bool nor vector.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::unique_ptr<Recorder> makeRecorder(
+    SignalBase<int>* signal);
+
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_RECORDER_HH
@@ -0,0 +1,113 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_SIGNAL_HANDLE_HH
+#define DYNAMIC_GRAPH_PYTHON_SIGNAL_HANDLE_HH
+
+#include <dynamic-graph/entity.h>
+#include <dynamic-graph/signal-base.h>
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dynamic-graph/python/api.hh"
+
+namespace dynamicgraph {
+namespace python {
+namespace pool {
+
+/// Reader-writer lock of the map of the entities of the pool.
+///
+/// The bindings take it shared to read the map, and exclusive to add
+/// entities, so that the threads reading the pool without the GIL, such as
+/// the monitor, do not serialize. It is never held while waiting for the GIL
+/// nor for another lock.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::shared_timed_mutex& poolMutex();
+
+typedef std::vector<std::pair<std::string, Entity*> > EntityList;
+
+/// Return the names and entities of the pool, in the order of the names.
+/// The list is never modified, and the same list is returned as long as the
+/// version of the pool does not change: the pool has no hook, so that the
+/// entities created or deleted from C++ without the bindings are only seen
+/// after a call to invalidate (notify_pool_changed in Python). The list does
+/// not keep the entities alive: they must not be accessed once entities may
+/// have been deleted.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::shared_ptr<const EntityList> snapshot();
+
+/// Signal of the pool designated by a path "entity.signal".
+///
+/// Handles are interned: there is a single handle per path, obtained with
+/// signalHandle. The path is parsed once, and the signal looked up in the
+/// pool is kept with the version of the pool, so that it is looked up again
+/// only once the version changed (see snapshot for the changes made from
+/// C++). A handle can be used from several threads.
+class DYNAMIC_GRAPH_PYTHON_DLLAPI SignalHandle {
+ public:
+  explicit SignalHandle(const std::string& path);
+
+  const std::string& path() const { return path_; }
+
+  /// \return the signal
+  /// \throw if there is no such signal in the pool.
+  SignalBase<int>& signal() const;
+
+  /// Whether the path designates a signal of the pool.
+  bool valid() const;
+
+  /// \return the signal if the path designates a signal of entity, else
+  ///         NULL.
+  SignalBase<int>* signalOf(const Entity& entity) const;
+
+ private:
+  /// \return the signal, or NULL if there is no such signal in the pool.
+  /// \param entity receives the entity of the signal.
+  SignalBase<int>* find(const Entity** entity = NULL) const;
+
+  std::string path_;
+  std::string entityName_;
+  std::string signalName_;
+
+  /// Signal found, or NULL, its entity and the version of the pool they
+  /// were looked up at, or -1.
+  mutable std::mutex mutex_;
+  mutable SignalBase<int>* signal_;
+  mutable const Entity* entity_;
+  mutable std::size_t version_;
+};
+
+/// Return the handle of path, creating it on the first call.
+DYNAMIC_GRAPH_PYTHON_DLLAPI SignalHandle& signalHandle(const std::string& path);
+
+/// Return the signal designated by a path "entity.signal".
+inline SignalBase<int>& resolveSignal(const std::string& path) {
+  return signalHandle(path).signal();
+}
+
+/// Return the path "entity.signal" of a signal registered in an entity of
+/// the pool.
+/// \throw std::invalid_argument if no entity of the pool has the signal.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::string signalPath(
+    const SignalBase<int>& signal);
+
+/// Return the paths "entity.signal" of the signals of the pool whose entity
+/// and signal names match patterns, in the order of the names.
+/// \param regex whether the patterns are regular expressions matching the
+///        whole names, instead of glob patterns with *, ? and [...].
+/// \throw std::invalid_argument if a pattern is not valid.
+DYNAMIC_GRAPH_PYTHON_DLLAPI std::vector<std::string> matchSignals(
+    const std::string& entityPattern, const std::string& signalPattern,
+    bool regex = false);
+
+}  // namespace pool
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_SIGNAL_HANDLE_HH
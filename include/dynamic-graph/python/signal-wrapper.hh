@@ -11,6 +11,7 @@
 #include <boost/bind.hpp>
 #include <boost/python.hpp>
 
+#include "dynamic-graph/python/gil.hh"
 #include "dynamic-graph/python/python-compat.hh"
 
 namespace dynamicgraph {
@@ -46,19 +47,27 @@ class SignalWrapper : public Signal<T, Time> {
 
  private:
   T& call(T& value, Time t) {
-    PyGILState_STATE gstate;
-    gstate = PyGILState_Ensure();
+    // The signal may be recomputed by a binding which released the GIL.
+    ScopedGILEnsure gil;
     if (PyGILState_GetThisThreadState() == NULL) {
       dgDEBUG(10) << "python thread not initialized" << std::endl;
     }
-    pyobject obj = callable(t);
-    value = boost::python::extract<T>(obj);
-    PyGILState_Release(gstate);
+    try {
+      pyobject obj = callable(t);
+      value = boost::python::extract<T>(obj);
+    } catch (const boost::python::error_already_set&) {
+      // The error indicator belongs to this thread, which may not be the
+      // one the error is raised in.
+      throw PythonError();
+    }
     return value;
   }
   pyobject callable;
 };
 
+/// Whether signal is a SignalWrapper, whose value is computed by Python.
+bool isSignalWrapper(const SignalBase<int>* signal);
+
 }  // namespace python
 }  // namespace dynamicgraph
 #endif
@@ -8,6 +8,8 @@
 #include <boost/python.hpp>
 #include <sstream>
 
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/input-log.hh"
 #include "dynamic-graph/python/signal-wrapper.hh"
 
 namespace dynamicgraph {
@@ -22,9 +24,15 @@ auto exposeSignal(const std::string& name) {
       name.c_str(), bp::init<std::string>());
   obj.add_property(
       "value",
-      bp::make_function(&S_t::accessCopy,
-                        bp::return_value_policy<bp::copy_const_reference>()),
-      &S_t::setConstant,  // TODO check the setter
+      +[](const S_t& signal) -> T {
+        ScopedGraphAccess graphAccess;
+        return signal.accessCopy();
+      },
+      +[](S_t& signal, const T& value) {
+        ScopedGraphAccess graphAccess;
+        signal.setConstant(value);
+        inputLog::record(signal);
+      },
       "the signal value.\n"
       "warning: for Eigen objects, sig.value[0] = 1. may not work).");
   return obj;
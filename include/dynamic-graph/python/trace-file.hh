@@ -0,0 +1,61 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_TRACE_FILE_HH
+#define DYNAMIC_GRAPH_PYTHON_TRACE_FILE_HH
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "dynamic-graph/python/api.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Output of dgDEBUG and DebugTrace.
+///
+/// Each thread writing to dg_debugfile gathers its text without lock until
+/// it ends a line. The lines matching the filter are then passed to a
+/// thread, which opens the file at the first trace and rotates it when it
+/// grows over a size.
+namespace trace {
+
+/// Make stream write to the trace file. Called once for dg_debugfile.
+DYNAMIC_GRAPH_PYTHON_DLLAPI bool install(std::ostream& stream);
+
+/// Write the traces to filename, which is truncated at the first trace.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void enable(const std::string& filename);
+
+/// Drop the traces, and close the file.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void disable();
+
+/// Rename the file "filename.1", "filename.2"... up to maxFiles - 1, when it
+/// would grow over maxBytes. 0 disables the rotation.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void setRotation(std::size_t maxBytes,
+                                             std::size_t maxFiles);
+
+/// Keep only the lines containing one of the tokens, such as entity names,
+/// class names or source files. An empty list keeps all the lines.
+///
+/// The lines are filtered once formatted by dgDEBUG: the filter saves the
+/// lock, the disk I/O and the size of the files, not the formatting. Compile
+/// the entities that need not be traced without VP_DEBUG to save it too.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void setFilter(
+    const std::vector<std::string>& tokens);
+
+/// Write text as dgDEBUG does, e.g. to mark the traces from Python.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void write(const std::string& text);
+
+/// Return once the traces written so far are in the file.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void flush();
+
+}  // namespace trace
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_TRACE_FILE_HH
@@ -0,0 +1,97 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_VALUE_FILE_HH
+#define DYNAMIC_GRAPH_PYTHON_VALUE_FILE_HH
+
+#include <dynamic-graph/signal-base.h>
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "dynamic-graph/python/api.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Binary files of signal values, such as the snapshots and the input logs.
+///
+/// The fields are in the byte order of the host, and every field starts at
+/// a multiple of 8 bytes, so that the values can be read in place from the
+/// mapped file:
+///
+///   string:   uint64 size, characters padded to 8 bytes
+///   value:    uint64 kind, payload
+///
+/// The payload of a value depends on its kind: a double, an int64 for ints
+/// and bools, uint64 size and doubles for vectors, uint64 rows and cols and
+/// the column major doubles for matrices, and a string holding the text
+/// written by SignalBase::get for the other types.
+namespace valueFile {
+
+class DYNAMIC_GRAPH_PYTHON_DLLAPI Writer {
+ public:
+  explicit Writer(const std::string& filename);
+
+  void write(const void* data, std::size_t size);
+  void write(std::uint64_t n) { write(&n, sizeof(n)); }
+  void write(const std::string& s) {
+    write(std::uint64_t(s.size()));
+    write(s.data(), s.size());
+  }
+
+  std::ofstream& file() { return file_; }
+
+ private:
+  std::ofstream file_;
+};
+
+/// Read only view of a whole file, mapped in memory where possible.
+class DYNAMIC_GRAPH_PYTHON_DLLAPI MappedFile {
+ public:
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  /// Whether the whole file was read.
+  bool atEnd() const { return pos_ >= size_; }
+
+  /// Return the address of the next size bytes, and skip them.
+  const char* read(std::size_t size);
+  std::uint64_t readSize();
+  std::string readString();
+  const double* readDoubles(std::uint64_t n);
+
+ private:
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+
+  std::string filename_;
+  const char* data_;
+  std::size_t size_;
+  std::size_t pos_;
+#ifdef _WIN32
+  std::vector<char> buffer_;
+#endif
+};
+
+/// Write the value last computed of signal.
+DYNAMIC_GRAPH_PYTHON_DLLAPI void writeValue(Writer& writer,
+                                            SignalBase<int>* signal);
+
+typedef std::function<void(SignalBase<int>&)> Setter;
+
+/// Read a value, and return the function setting it as the constant value
+/// of a signal. The function must be called while the file is open.
+DYNAMIC_GRAPH_PYTHON_DLLAPI Setter readValue(MappedFile& file);
+
+}  // namespace valueFile
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_VALUE_FILE_HH
@@ -0,0 +1,241 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include <dynamic-graph/signal-base.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+
+namespace dynamicgraph {
+namespace python {
+namespace aio {
+
+namespace {
+
+/// Signal whose time is awaited.
+struct Wait {
+  /// Path of the signal, looked up at each comparison, so that a signal
+  /// removed from the pool is never read.
+  pool::SignalHandle* handle;
+  int time;
+};
+
+/// Thread comparing the times of the awaited signals, while there are any,
+/// and making a file descriptor readable when some of them are reached, so
+/// that an event loop is woken up instead of polling.
+class Bridge {
+ public:
+  Bridge()
+      : readFd_(-1), writeFd_(-1), nextId_(1), running_(false), period_(1e-3) {}
+
+  ~Bridge() { close(); }
+
+  int fd() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    open();
+    return readFd_;
+  }
+
+  std::size_t wait(const Wait& wait) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    open();
+    const std::size_t id = nextId_++;
+    waits_[id] = wait;
+    wake_.notify_one();
+    return id;
+  }
+
+  void cancel(std::size_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    waits_.erase(id);
+  }
+
+  std::vector<std::size_t> ready() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+    std::vector<std::size_t> ready;
+    ready.swap(ready_);
+    return ready;
+  }
+
+  void setPeriod(double period) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    period_ = period;
+  }
+
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) return;
+      running_ = false;
+    }
+    wake_.notify_all();
+    thread_.join();
+#ifndef _WIN32
+    ::close(readFd_);
+    if (writeFd_ != readFd_) ::close(writeFd_);
+#endif
+    readFd_ = writeFd_ = -1;
+  }
+
+ private:
+  /// Create the file descriptor and start the thread, at the first use.
+  void open() {
+    if (running_) return;
+#ifdef _WIN32
+    throw std::runtime_error("asyncio integration is not supported on Windows");
+#else
+#ifdef __linux__
+    readFd_ = writeFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (readFd_ < 0) throw std::runtime_error("cannot create an eventfd");
+#else
+    int fds[2];
+    if (::pipe(fds) != 0) throw std::runtime_error("cannot create a pipe");
+    for (int fd : fds) {
+      ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    readFd_ = fds[0];
+    writeFd_ = fds[1];
+#endif
+    running_ = true;
+    thread_ = std::thread(&Bridge::loop, this);
+#endif
+  }
+
+  void loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+      if (waits_.empty())
+        wake_.wait(lock);
+      else
+        wake_.wait_for(lock, std::chrono::duration<double>(period_));
+      if (!running_ || waits_.empty()) continue;
+      const std::size_t before = ready_.size();
+      {
+        // Never taken with the GIL, see gil.hh.
+        std::lock_guard<std::recursive_mutex> graphLock(graphMutex());
+        for (auto it = waits_.begin(); it != waits_.end();) {
+          if (reached(it->second)) {
+            ready_.push_back(it->first);
+            it = waits_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+      if (ready_.size() > before) notify();
+    }
+  }
+
+  static bool reached(const Wait& wait) {
+    return wait.handle->valid() && wait.handle->signal().getTime() >= wait.time;
+  }
+
+  void notify() {
+#ifndef _WIN32
+    const std::uint64_t one = 1;
+    // Fails only when the descriptor is readable already.
+    if (::write(writeFd_, &one, writeFd_ == readFd_ ? sizeof(one) : 1) < 0)
+      return;
+#endif
+  }
+
+  void drain() {
+#ifndef _WIN32
+    if (readFd_ < 0) return;
+    char buffer[64];
+    while (::read(readFd_, buffer, sizeof(buffer)) > 0) {
+    }
+#endif
+  }
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  int readFd_, writeFd_;
+  std::map<std::size_t, Wait> waits_;
+  std::vector<std::size_t> ready_;
+  std::size_t nextId_;
+  bool running_;
+  double period_;
+  std::thread thread_;
+};
+
+Bridge& bridge() {
+  // Never deleted: the thread is stopped by an atexit handler.
+  static Bridge* instance = new Bridge;
+  return *instance;
+}
+
+void stop() {
+  ScopedGILRelease nogil;
+  bridge().close();
+}
+
+}  // namespace
+
+int fd() {
+  static bool registered = false;
+  if (!registered) {
+    bp::import("atexit").attr("register")(bp::make_function(&stop));
+    registered = true;
+  }
+  ScopedGILRelease nogil;
+  return bridge().fd();
+}
+
+std::size_t waitTime(bp::object signal, int time) {
+  fd();
+  Wait wait;
+  wait.time = time;
+  bp::extract<std::string> path(signal);
+  wait.handle = &pool::signalHandle(
+      path.check() ? path() : pool::signalPath(*pool::toSignal(signal.ptr())));
+  ScopedGILRelease nogil;
+  return bridge().wait(wait);
+}
+
+void cancel(std::size_t id) {
+  ScopedGILRelease nogil;
+  bridge().cancel(id);
+}
+
+bp::list ready() {
+  std::vector<std::size_t> ids;
+  {
+    ScopedGILRelease nogil;
+    ids = bridge().ready();
+  }
+  return to_py_list(ids.begin(), ids.end());
+}
+
+void setPeriod(double period) {
+  if (!(period > 0)) throw std::invalid_argument("the period must be > 0");
+  ScopedGILRelease nogil;
+  bridge().setPeriod(period);
+}
+
+}  // namespace aio
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,81 @@
+# Copyright (C) 2026 CNRS
+"""
+Integration of the graph with asyncio.
+
+The waits are handled by a thread of the bindings, which makes the file
+descriptor wrap.aio_fd readable once some of them are over: the event loop
+is woken up by it instead of polling the graph.
+"""
+
+import asyncio
+import concurrent.futures
+import functools
+
+from . import wrap
+
+_futures = {}
+_loop = None
+_executor = None
+
+
+def _on_ready():
+    for id in wrap.aio_ready():
+        future = _futures.pop(id, None)
+        if future is not None and not future.done():
+            future.set_result(None)
+
+
+def _attach(loop):
+    global _loop
+    if _loop is loop:
+        return
+    if _loop is not None and not _loop.is_closed():
+        _loop.remove_reader(wrap.aio_fd())
+    loop.add_reader(wrap.aio_fd(), _on_ready)
+    _loop = loop
+
+
+def at(signal, time):
+    """
+    Return a future of the running event loop, done once a signal is
+    computed at time or later.
+
+    - signal: a signal or a path "entity.signal".
+
+    Also available as the method at of the signals: await sig.at(t).
+    """
+    loop = asyncio.get_running_loop()
+    _attach(loop)
+    future = loop.create_future()
+    id = wrap.aio_wait_time(signal, time)
+    _futures[id] = future
+
+    def cancel(future):
+        if future.cancelled():
+            _futures.pop(id, None)
+            wrap.aio_cancel(id)
+
+    future.add_done_callback(cancel)
+    return future
+
+
+def executor():
+    """
+    Return the executor of the commands, a single thread, so that they are
+    executed in order and out of the event loop.
+    """
+    global _executor
+    if _executor is None:
+        _executor = concurrent.futures.ThreadPoolExecutor(
+            max_workers=1, thread_name_prefix="dynamic_graph.aio"
+        )
+    return _executor
+
+
+async def call(command, *args):
+    """
+    Execute a command, such as entity.setValue, in the executor, and return
+    its result.
+    """
+    loop = asyncio.get_running_loop()
+    return await loop.run_in_executor(executor(), functools.partial(command, *args))
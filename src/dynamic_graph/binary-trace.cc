@@ -0,0 +1,71 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "dynamic-graph/python/binary-trace.hh"
+
+#include <cstring>
+
+namespace dynamicgraph {
+namespace python {
+namespace binaryTrace {
+
+namespace {
+
+const char magic[8] = {'D', 'G', 'T', 'R', 'A', 'C', 'E', '1'};
+/// Size of the magic number and of the four uint32 fields.
+const std::size_t fixedSize = 24;
+
+}  // namespace
+
+Header makeHeader(const std::string& name, std::size_t cols) {
+  Header header;
+  header.size = std::uint32_t((fixedSize + name.size() + 7) / 8 * 8);
+  header.width = std::uint32_t(cols > 0 ? cols : 1);
+  header.dimension = cols > 0 ? 1u : 0u;
+  header.name = name;
+  return header;
+}
+
+std::size_t recordSize(const Header& header) {
+  return sizeof(std::int64_t) + header.width * sizeof(double);
+}
+
+void writeHeader(const Header& header, char* data) {
+  std::memset(data, 0, header.size);
+  std::memcpy(data, magic, sizeof(magic));
+  const std::uint32_t fields[4] = {header.size, header.width,
+                                   header.dimension,
+                                   std::uint32_t(header.name.size())};
+  std::memcpy(data + sizeof(magic), fields, sizeof(fields));
+  std::memcpy(data + fixedSize, header.name.data(), header.name.size());
+}
+
+bool readHeader(const char* data, std::size_t size, Header& header) {
+  if (size < fixedSize || std::memcmp(data, magic, sizeof(magic)) != 0)
+    return false;
+  std::uint32_t fields[4];
+  std::memcpy(fields, data + sizeof(magic), sizeof(fields));
+  if (fields[0] > size || fixedSize + fields[3] > fields[0]) return false;
+  header.size = fields[0];
+  header.width = fields[1];
+  header.dimension = fields[2];
+  header.name.assign(data + fixedSize, fields[3]);
+  return true;
+}
+
+double* writeRecord(char* data, std::int64_t time) {
+  std::memcpy(data, &time, sizeof(time));
+  return reinterpret_cast<double*>(data + sizeof(time));
+}
+
+const double* readRecord(const char* data, std::int64_t& time) {
+  std::memcpy(&time, data, sizeof(time));
+  return reinterpret_cast<const double*>(data + sizeof(time));
+}
+
+}  // namespace binaryTrace
+}  // namespace python
+}  // namespace dynamicgraph
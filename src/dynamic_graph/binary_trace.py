@@ -0,0 +1,62 @@
+# Copyright (C) 2026 CNRS
+"""
+Loader of the binary files written by TracerRealTimeBinary, in the format
+of dynamic-graph/python/binary-trace.hh.
+
+The records are mapped in memory with numpy.memmap, so that opening a trace
+does not depend on its length.
+"""
+
+import collections
+import struct
+
+import numpy as np
+
+Header = collections.namedtuple("Header", ["size", "width", "ndim", "name"])
+
+_MAGIC = b"DGTRACE1"
+_HEADER = struct.Struct("=8sIIII")
+
+
+def header(filename):
+    """
+    Read the header of a trace file.
+    """
+    with open(filename, "rb") as f:
+        data = f.read(_HEADER.size)
+        if len(data) < _HEADER.size:
+            raise ValueError("%s is not a binary trace" % filename)
+        magic, size, width, ndim, name_size = _HEADER.unpack(data)
+        if magic != _MAGIC:
+            raise ValueError("%s is not a binary trace" % filename)
+        name = f.read(name_size).decode(errors="replace")
+    return Header(size, width, ndim, name)
+
+
+def dtype(head):
+    """
+    Return the numpy type of the records of a trace, of fields "time" and
+    "value".
+    """
+    value = ("value", "=f8") if head.ndim == 0 else ("value", "=f8", (head.width,))
+    return np.dtype([("time", "=i8"), value])
+
+
+def load(filename, mode="r"):
+    """
+    Map the records of a trace file as a numpy array of records of fields
+    "time" and "value".
+
+    The records written after the call are not mapped, and an incomplete last
+    record is ignored, so that traces can be loaded while they are written.
+    """
+    head = header(filename)
+    records = dtype(head)
+    with open(filename, "rb") as f:
+        f.seek(0, 2)
+        count = (f.tell() - head.size) // records.itemsize
+    if count <= 0:
+        return np.zeros(0, dtype=records)
+    return np.memmap(
+        filename, dtype=records, mode=mode, offset=head.size, shape=(count,)
+    )
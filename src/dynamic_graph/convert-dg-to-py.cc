@@ -6,9 +6,13 @@
 #include <dynamic-graph/signal-caster.h>
 #include <dynamic-graph/signal.h>
 
+#include <algorithm>
 #include <boost/python.hpp>
 #include <boost/python/stl_iterator.hpp>
+#include <cctype>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #include "dynamic-graph/python/python-compat.hh"
@@ -22,42 +26,533 @@ namespace convert {
 
 namespace bp = boost::python;
 
-command::Value toValue(bp::object o, const command::Value::Type& valueType) {
-  using command::Value;
+namespace {
+
+using command::Value;
+
+template <typename T>
+void appendValue(std::vector<Value>& values, PyObject* o) {
+  values.emplace_back(bp::extract<T>(o)());
+}
+
+void appendBool(std::vector<Value>& values, PyObject* o) {
+  if (PyBool_Check(o))
+    values.emplace_back(o == Py_True);
+  else
+    appendValue<bool>(values, o);
+}
+
+void appendInt(std::vector<Value>& values, PyObject* o) {
+  if (PyLong_CheckExact(o)) {
+    int overflow;
+    long v = PyLong_AsLongAndOverflow(o, &overflow);
+    if (overflow == 0 && v >= std::numeric_limits<int>::min() &&
+        v <= std::numeric_limits<int>::max()) {
+      values.emplace_back(int(v));
+      return;
+    }
+  }
+  // Let boost::python raise the appropriate error.
+  appendValue<int>(values, o);
+}
+
+void appendFloat(std::vector<Value>& values, PyObject* o) {
+  if (PyFloat_CheckExact(o))
+    values.emplace_back(float(PyFloat_AS_DOUBLE(o)));
+  else
+    appendValue<float>(values, o);
+}
+
+void appendDouble(std::vector<Value>& values, PyObject* o) {
+  if (PyFloat_CheckExact(o))
+    values.emplace_back(PyFloat_AS_DOUBLE(o));
+  else
+    appendValue<double>(values, o);
+}
+
+/// Read access to the buffer exported by a Python object, such as a numpy
+/// array, without copying it.
+class Buffer {
+ public:
+  explicit Buffer(PyObject* o) : acquired_(false) {
+    if (!PyObject_CheckBuffer(o)) return;
+    if (PyObject_GetBuffer(o, &view_, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+      PyErr_Clear();
+      return;
+    }
+    acquired_ = true;
+  }
+  ~Buffer() {
+    if (acquired_) PyBuffer_Release(&view_);
+  }
+
+  bool acquired() const { return acquired_; }
+  int ndim() const { return view_.ndim; }
+  Eigen::Index size(int i) const { return view_.shape[i]; }
+  /// Stride along dimension \c i, in number of doubles.
+  Eigen::Index stride(int i) const {
+    return view_.strides[i] / Py_ssize_t(sizeof(double));
+  }
+  const double* data() const { return static_cast<const double*>(view_.buf); }
+
+  /// Whether the buffer holds native doubles that Eigen can map, i.e. with
+  /// positive strides multiple of the size of a double.
+  bool isDouble() const {
+    if (order() != NATIVE) return false;
+    for (int i = 0; i < view_.ndim; ++i)
+      if (view_.strides[i] <= 0 || view_.strides[i] % sizeof(double) != 0)
+        return false;
+    return true;
+  }
+
+  /// Whether the buffer holds doubles in the byte order opposite to the one
+  /// of the host.
+  bool isSwappedDouble() const { return order() == SWAPPED; }
+
+ private:
+  enum Order { NOT_DOUBLE, NATIVE, SWAPPED };
+
+  /// Byte order of the doubles of the buffer.
+  Order order() const {
+    if (!acquired_ || view_.itemsize != sizeof(double) || view_.format == NULL)
+      return NOT_DOUBLE;
+    const char* f = view_.format;
+#if PY_LITTLE_ENDIAN
+    const bool swapped = *f == '>' || *f == '!';
+    if (*f == '@' || *f == '=' || *f == '<' || swapped) ++f;
+#else
+    const bool swapped = *f == '<';
+    if (*f == '@' || *f == '=' || *f == '>' || *f == '!' || swapped) ++f;
+#endif
+    if (f[0] != 'd' || f[1] != '\0') return NOT_DOUBLE;
+    return swapped ? SWAPPED : NATIVE;
+  }
+
+
+  Py_buffer view_;
+  bool acquired_;
+};
+
+/// Call append with a copy of the array o in native doubles, made by numpy.
+void appendNative(std::vector<Value>& values, PyObject* o,
+                  void (*append)(std::vector<Value>&, PyObject*)) {
+  bp::object native =
+      bp::object(bp::handle<>(bp::borrowed(o))).attr("astype")("d");
+  append(values, native.ptr());
+}
+
+void appendVector(std::vector<Value>& values, PyObject* o) {
+  Buffer buffer(o);
+  if (buffer.isSwappedDouble()) return appendNative(values, o, &appendVector);
+  if (buffer.isDouble() && buffer.ndim() == 1) {
+    // Value only takes a Vector, which it copies: the buffer is read once into
+    // it, instead of going through a Python conversion.
+    values.emplace_back(Vector(
+        Eigen::Map<const Vector, Eigen::Unaligned, Eigen::InnerStride<> >(
+            buffer.data(), buffer.size(0),
+            Eigen::InnerStride<>(buffer.stride(0)))));
+  } else
+    appendValue<Vector>(values, o);
+}
+
+void appendMatrix(std::vector<Value>& values, PyObject* o) {
+  typedef Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic> Stride;
+  Buffer buffer(o);
+  if (buffer.isSwappedDouble()) return appendNative(values, o, &appendMatrix);
+  if (buffer.isDouble() && buffer.ndim() == 2) {
+    values.emplace_back(
+        Matrix(Eigen::Map<const Matrix, Eigen::Unaligned, Stride>(
+            buffer.data(), buffer.size(0), buffer.size(1),
+            Stride(buffer.stride(1), buffer.stride(0)))));
+  } else
+    appendValue<Matrix>(values, o);
+}
+
+void appendInferred(std::vector<Value>& values, PyObject* o);
+
+/// The type of the values is inferred from the type of the Python objects:
+/// bool, int, float, str, 1D and 2D arrays, and sequences of them.
+void appendValues(std::vector<Value>& values, PyObject* o) {
+  if (!PyList_Check(o) && !PyTuple_Check(o))
+    throw std::invalid_argument("expected a list or a tuple, got " +
+                                obj_to_str(o));
+  std::vector<Value> inner;
+  inner.reserve(std::size_t(PySequence_Fast_GET_SIZE(o)));
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(o); ++i)
+    appendInferred(inner, PySequence_Fast_GET_ITEM(o, i));
+  values.emplace_back(inner);
+}
+
+void appendInferred(std::vector<Value>& values, PyObject* o) {
+  if (PyBool_Check(o))
+    appendBool(values, o);
+  else if (PyFloat_Check(o))
+    appendDouble(values, o);
+  else if (PyUnicode_Check(o))
+    appendValue<std::string>(values, o);
+  else if (PyList_Check(o) || PyTuple_Check(o))
+    appendValues(values, o);
+  else {
+    int ndim;
+    {
+      Buffer buffer(o);
+      ndim = buffer.acquired() ? buffer.ndim() : -1;
+    }
+    if (ndim == 1)
+      appendVector(values, o);
+    else if (ndim == 2)
+      appendMatrix(values, o);
+    else if (PyIndex_Check(o)) {
+      bp::object index(bp::handle<>(PyNumber_Index(o)));
+      appendInt(values, index.ptr());
+    } else if (PyNumber_Check(o)) {
+      double d = PyFloat_AsDouble(o);
+      if (d == -1. && PyErr_Occurred()) bp::throw_error_already_set();
+      values.emplace_back(d);
+    } else
+      throw std::invalid_argument("cannot infer the value type of " +
+                                  obj_to_str(o));
+  }
+}
+
+void appendNone(std::vector<Value>& values, PyObject*) {
+  std::cerr << "Only int, double and string are supported." << std::endl;
+  values.emplace_back();
+}
+
+}  // namespace
+
+ValueAppender valueAppender(const Value::Type& valueType) {
   switch (valueType) {
     case (Value::BOOL):
-      return Value(bp::extract<bool>(o));
+      return &appendBool;
     case (Value::UNSIGNED):
-      return Value(bp::extract<unsigned>(o));
+      return &appendValue<unsigned>;
     case (Value::INT):
-      return Value(bp::extract<int>(o));
+      return &appendInt;
     case (Value::FLOAT):
-      return Value(bp::extract<float>(o));
+      return &appendFloat;
     case (Value::DOUBLE):
-      return Value(bp::extract<double>(o));
+      return &appendDouble;
     case (Value::STRING):
-      return Value(bp::extract<std::string>(o));
+      return &appendValue<std::string>;
     case (Value::VECTOR):
       // TODO for backward compatibility, support tuple or list ?
       // I don't think so
-      return Value(bp::extract<Vector>(o));
+      return &appendVector;
     case (Value::MATRIX):
       // TODO for backward compatibility, support tuple or list ?
       // I don't think so
-      return Value(bp::extract<Matrix>(o));
+      return &appendMatrix;
     case (Value::MATRIX4D):
-      return Value(bp::extract<Eigen::Matrix4d>(o));
+      return &appendValue<Eigen::Matrix4d>;
     case (Value::VALUES):
-      // TODO the vector of values cannot be built since
-      // - the value type inside the vector are not know
-      // - inferring the value type from the Python type is not implemented.
-      throw std::invalid_argument(
-          "not implemented: cannot create a vector of values");
-      break;
+      return &appendValues;
     default:
-      std::cerr << "Only int, double and string are supported." << std::endl;
+      return &appendNone;
+  }
+}
+
+command::Value toValue(bp::object o, const command::Value::Type& valueType) {
+  std::vector<command::Value> values;
+  valueAppender(valueType)(values, o.ptr());
+  return values.front();
+}
+
+namespace {
+
+/// Python object exporting a buffer of doubles through the buffer protocol.
+/// It owns either a C++ object, or a reference to the Python object owning
+/// the memory.
+struct ArrayOwner {
+  PyObject ob_base;
+  double* data;
+  int ndim;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+  void* owned;
+  void (*release)(void*);
+  PyObject* base;
+};
+
+int arrayOwnerGetBuffer(PyObject* self, Py_buffer* view, int flags) {
+  ArrayOwner* owner = reinterpret_cast<ArrayOwner*>(self);
+  bool cContiguous = owner->ndim < 2 || owner->shape[0] < 2 ||
+                     owner->strides[0] == owner->shape[1] * owner->strides[1];
+  cContiguous = cContiguous && owner->strides[owner->ndim - 1] ==
+                                   Py_ssize_t(sizeof(double));
+  if (((flags & PyBUF_STRIDES) != PyBUF_STRIDES ||
+       (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS) &&
+      !cContiguous) {
+    PyErr_SetString(PyExc_BufferError, "the buffer is not C contiguous");
+    return -1;
+  }
+  view->obj = self;
+  Py_INCREF(self);
+  view->buf = owner->data;
+  view->itemsize = sizeof(double);
+  view->len = sizeof(double);
+  for (int i = 0; i < owner->ndim; ++i) view->len *= owner->shape[i];
+  view->readonly = 0;
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : NULL;
+  view->ndim = owner->ndim;
+  view->shape = (flags & PyBUF_ND) ? owner->shape : NULL;
+  view->strides = (flags & PyBUF_STRIDES) ? owner->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  return 0;
+}
+
+void arrayOwnerDealloc(PyObject* self) {
+  ArrayOwner* owner = reinterpret_cast<ArrayOwner*>(self);
+  if (owner->release) owner->release(owner->owned);
+  Py_XDECREF(owner->base);
+  Py_TYPE(self)->tp_free(self);
+}
+
+// The fields of the type after its header are set below, in the same way for
+// all the versions of Python.
+#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 2))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#endif
+PyTypeObject* arrayOwnerType() {
+  static PyBufferProcs procs = {&arrayOwnerGetBuffer, NULL};
+  static PyTypeObject type = {PyVarObject_HEAD_INIT(NULL, 0)};
+  if (!(type.tp_flags & Py_TPFLAGS_READY)) {
+    type.tp_name = "dynamic_graph.ArrayOwner";
+    type.tp_basicsize = sizeof(ArrayOwner);
+    type.tp_dealloc = &arrayOwnerDealloc;
+    type.tp_as_buffer = &procs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    if (PyType_Ready(&type) < 0) bp::throw_error_already_set();
+  }
+  return &type;
+}
+#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 2))
+#pragma GCC diagnostic pop
+#endif
+
+/// Make a numpy array of a buffer exported by an ArrayOwner.
+bp::object asArray(ArrayOwner* owner) {
+  static bp::object* asarray =
+      new bp::object(bp::import("numpy").attr("asarray"));
+  bp::object o(bp::handle<>(reinterpret_cast<PyObject*>(owner)));
+  return (*asarray)(o);
+}
+
+ArrayOwner* newArrayOwner(double* data, int ndim, const Py_ssize_t* shape,
+                          const Py_ssize_t* strides) {
+  ArrayOwner* owner = PyObject_New(ArrayOwner, arrayOwnerType());
+  if (owner == NULL) bp::throw_error_already_set();
+  owner->data = data;
+  owner->ndim = ndim;
+  for (int i = 0; i < ndim; ++i) {
+    owner->shape[i] = shape[i];
+    owner->strides[i] = strides[i];
+  }
+  owner->owned = NULL;
+  owner->release = NULL;
+  owner->base = NULL;
+  return owner;
+}
+
+/// Numpy array taking the ownership of an Eigen column major matrix.
+template <typename MatrixType>
+bp::object ownedArray(MatrixType* m) {
+  Py_ssize_t shape[2] = {m->rows(), m->cols()};
+  Py_ssize_t strides[2] = {Py_ssize_t(sizeof(double)),
+                           Py_ssize_t(sizeof(double)) * m->rows()};
+  ArrayOwner* owner;
+  try {
+    owner =
+        newArrayOwner(m->data(), MatrixType::IsVectorAtCompileTime ? 1 : 2,
+                      shape, strides);
+  } catch (...) {
+    delete m;
+    throw;
+  }
+  owner->owned = m;
+  owner->release = [](void* p) { delete static_cast<MatrixType*>(p); };
+  return asArray(owner);
+}
+
+/// Reader of the text of the vectors and matrices written by dynamic-graph.
+class TextReader {
+ public:
+  explicit TextReader(const std::string& text)
+      : text_(text), p_(text_.c_str()) {}
+
+  void expect(char c) {
+    skipSpaces();
+    if (*p_ != c) fail(std::string("expected '") + c + "'");
+    ++p_;
+  }
+  bool accept(char c) {
+    skipSpaces();
+    if (*p_ != c) return false;
+    ++p_;
+    return true;
+  }
+  Py_ssize_t size() {
+    skipSpaces();
+    char* end;
+    long n = std::strtol(p_, &end, 10);
+    if (end == p_ || n < 0) fail("expected a size");
+    p_ = end;
+    return n;
+  }
+  /// Read a number whatever the locale, with the GIL.
+  double number() {
+    skipSpaces();
+    char* end;
+    double x = PyOS_string_to_double(p_, &end, NULL);
+    if (end == p_) {
+      PyErr_Clear();
+      fail("expected a number");
+    }
+    p_ = end;
+    return x;
   }
-  return Value();
+  /// Read n numbers separated by commas between parentheses.
+  void numbers(Py_ssize_t n, double* data) {
+    expect('(');
+    for (Py_ssize_t i = 0; i < n; ++i) {
+      if (i > 0) expect(',');
+      data[i] = number();
+    }
+    expect(')');
+  }
+  void end() {
+    skipSpaces();
+    if (*p_ != '\0') fail("unexpected characters");
+  }
+
+ private:
+  void skipSpaces() {
+    while (std::isspace(static_cast<unsigned char>(*p_))) ++p_;
+  }
+  void fail(const std::string& message) const {
+    std::ostringstream oss;
+    oss << "cannot read \"" << text_ << "\" as a vector or a matrix: "
+        << message << " at position " << p_ - text_.c_str();
+    throw std::invalid_argument(oss.str());
+  }
+
+  const std::string text_;
+  const char* p_;
+};
+
+/// Shortest text of x read back as x, as repr and whatever the locale,
+/// with the GIL.
+void appendNumber(std::string& text, double x) {
+  char* buffer = PyOS_double_to_string(x, 'r', 0, 0, NULL);
+  if (buffer == NULL) bp::throw_error_already_set();
+  text += buffer;
+  PyMem_Free(buffer);
+}
+
+/// Append n numbers separated by commas between parentheses.
+void appendNumbers(std::string& text, const double* data, Eigen::Index n,
+                   Eigen::Index stride) {
+  text += '(';
+  for (Eigen::Index i = 0; i < n; ++i) {
+    if (i > 0) text += ',';
+    appendNumber(text, data[i * stride]);
+  }
+  text += ')';
+}
+
+}  // namespace
+
+bp::object stringToArray(const std::string& text) {
+  TextReader reader(text);
+  reader.expect('[');
+  Py_ssize_t rows = reader.size(), cols = 0;
+  const bool matrix = reader.accept(',');
+  if (matrix) cols = reader.size();
+  reader.expect(']');
+  bp::object array;
+  double* data;
+  if (!matrix) {
+    array = newArray(rows, 0, &data);
+    reader.numbers(rows, data);
+  } else if (rows == 0 || cols == 0) {
+    array = bp::import("numpy").attr("zeros")(bp::make_tuple(rows, cols));
+    reader.expect('(');
+    while (reader.accept('(')) reader.expect(')');
+    reader.expect(')');
+  } else {
+    array = newArray(rows, cols, &data);
+    reader.expect('(');
+    for (Py_ssize_t i = 0; i < rows; ++i) {
+      if (i > 0) reader.expect(',');
+      reader.numbers(cols, data + i * cols);
+    }
+    reader.expect(')');
+  }
+  reader.end();
+  return array;
+}
+
+std::string arrayToString(bp::object o) {
+  static bp::object* require =
+      new bp::object(bp::import("numpy").attr("require"));
+  bp::object array = (*require)(o, "float64", "C");
+  Buffer buffer(array.ptr());
+  if (!buffer.isDouble() || buffer.ndim() > 2)
+    throw std::invalid_argument("expected a number, a vector or a matrix");
+  std::string text;
+  if (buffer.ndim() == 0) {
+    appendNumber(text, *buffer.data());
+  } else if (buffer.ndim() == 1) {
+    text = "[" + std::to_string(buffer.size(0)) + "]";
+    appendNumbers(text, buffer.data(), buffer.size(0), buffer.stride(0));
+  } else {
+    text = "[" + std::to_string(buffer.size(0)) + "," +
+           std::to_string(buffer.size(1)) + "](";
+    if (buffer.size(0) == 0) text += "()";
+    for (Eigen::Index i = 0; i < buffer.size(0); ++i) {
+      if (i > 0) text += ',';
+      appendNumbers(text, buffer.data() + i * buffer.stride(0),
+                    buffer.size(1), buffer.stride(1));
+    }
+    text += ')';
+  }
+  return text;
+}
+
+bp::object newArray(Py_ssize_t rows, Py_ssize_t cols, double** data) {
+  Vector* v = new Vector(Vector::Zero(rows * std::max(cols, Py_ssize_t(1))));
+  Py_ssize_t shape[2] = {rows, cols};
+  Py_ssize_t strides[2] = {Py_ssize_t(sizeof(double)) * cols,
+                           Py_ssize_t(sizeof(double))};
+  ArrayOwner* owner;
+  try {
+    owner = newArrayOwner(v->data(), cols > 0 ? 2 : 1, shape,
+                          cols > 0 ? strides : strides + 1);
+  } catch (...) {
+    delete v;
+    throw;
+  }
+  owner->owned = v;
+  owner->release = [](void* p) { delete static_cast<Vector*>(p); };
+  *data = v->data();
+  return asArray(owner);
+}
+
+bp::object viewArray(double* data, Py_ssize_t rows, Py_ssize_t cols,
+                     const std::shared_ptr<void>& owner) {
+  Py_ssize_t shape[2] = {rows, cols};
+  Py_ssize_t strides[2] = {Py_ssize_t(sizeof(double)) * cols,
+                           Py_ssize_t(sizeof(double))};
+  ArrayOwner* array = newArrayOwner(data, cols > 0 ? 2 : 1, shape,
+                                    cols > 0 ? strides : strides + 1);
+  array->owned = new std::shared_ptr<void>(owner);
+  array->release = [](void* p) {
+    delete static_cast<std::shared_ptr<void>*>(p);
+  };
+  return asArray(array);
 }
 
 bp::object fromValue(const command::Value& value) {
@@ -75,10 +570,12 @@ bp::object fromValue(const command::Value& value) {
       return bp::object(value.doubleValue());
     case (Value::STRING):
       return bp::object(value.stringValue());
+    // The copy returned by Value is moved into the array instead of being
+    // copied again by eigenpy.
     case (Value::VECTOR):
-      return bp::object(value.vectorValue());
+      return ownedArray(new Vector(value.vectorValue()));
     case (Value::MATRIX):
-      return bp::object(value.matrixXdValue());
+      return ownedArray(new Matrix(value.matrixXdValue()));
     case (Value::MATRIX4D):
       return bp::object(value.matrix4dValue());
     case (Value::VALUES): {
@@ -2,6 +2,7 @@
 //
 // See LICENSE
 
+#include <algorithm>
 #include <iostream>
 
 #define ENABLE_RT_LOG
@@ -9,11 +10,32 @@
 #include <dynamic-graph/pool.h>
 #include <dynamic-graph/real-time-logger.h>
 
+#include <atomic>
 #include <boost/shared_ptr.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
 
 typedef boost::shared_ptr<std::ofstream> ofstreamShrPtr;
 
@@ -38,11 +60,492 @@ void closeLoggerFileOutputStream() {
   for (const auto& el : mapOfFiles_) el.second->close();
 }
 
+namespace {
+
+/// Logger stream forwarding the messages to the streams added by the
+/// bindings, so that they can be removed: the RealTimeLogger keeps its
+/// streams until it is destroyed. The lock is only taken by the thread
+/// running RealTimeLogger::spinOnce, and by the bindings adding or removing
+/// a stream.
+class StreamList : public LoggerStream {
+ public:
+  void write(const char* c) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const LoggerStreamPtr_t& stream : streams_) stream->write(c);
+  }
+
+  void add(const LoggerStreamPtr_t& stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams_.push_back(stream);
+  }
+
+  /// Once removed, the stream is no longer written.
+  void remove(const LoggerStreamPtr_t& stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams_.erase(std::remove(streams_.begin(), streams_.end(), stream),
+                   streams_.end());
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<LoggerStreamPtr_t> streams_;
+};
+
+/// Added to the RealTimeLogger by the first call to streamList, and
+/// dropped with it by realTimeLoggerDestroy.
+boost::shared_ptr<StreamList> streamList_;
+
+StreamList& streamList() {
+  if (!streamList_) {
+    streamList_.reset(new StreamList);
+    RealTimeLogger::instance().addOutputStream(streamList_);
+  }
+  return *streamList_;
+}
+
+/// Logger stream writing each message as a binary record to preallocated,
+/// memory mapped segments "<prefix>.<index>.dglog".
+///
+/// A segment starts with a header of 4 fields of 8 bytes: the magic
+/// "DGRTLOG1", the index of the segment, its size and the end offset of its
+/// last record. The latter is updated after each record, so that a reader
+/// can follow the log while it is being written. A record is made of
+///   uint32 size of the record, padded to 8 bytes,
+///   uint32 size of the message,
+///   the message.
+/// The logger gives the text of the messages only: their type, their entity
+/// and the time they were logged are not known by the stream.
+///
+/// The stream is written by the thread running RealTimeLogger::spinOnce
+/// only, and takes no lock.
+class BinaryLoggerStream : public LoggerStream {
+ public:
+  BinaryLoggerStream(const std::string& prefix, std::size_t segmentSize)
+      : prefix_(prefix),
+        segmentSize_(segmentSize),
+        index_(0),
+        data_(NULL),
+        end_(NULL),
+        used_(0) {
+    if (segmentSize_ < headerSize + recordHeaderSize + 8)
+      throw std::invalid_argument("the segments are too small");
+    openSegment();
+  }
+
+  ~BinaryLoggerStream() { closeSegment(); }
+
+  void write(const char* c) {
+    if (data_ == NULL) return;
+    // Long messages are cut to the size of a segment.
+    std::size_t messageSize = std::min(
+        std::strlen(c), segmentSize_ - headerSize - recordHeaderSize);
+    std::size_t size = padded(recordHeaderSize + messageSize);
+    if (used_ + size > segmentSize_) {
+      closeSegment();
+      ++index_;
+      try {
+        openSegment();
+      } catch (const std::exception& exc) {
+        std::cerr << "Stop logging to " << prefix_ << ": " << exc.what()
+                  << std::endl;
+        return;
+      }
+    }
+
+    char* record = data_ + used_;
+    std::uint32_t header[2] = {std::uint32_t(size),
+                               std::uint32_t(messageSize)};
+    std::memcpy(record, header, sizeof(header));
+    std::memcpy(record + recordHeaderSize, c, messageSize);
+    used_ += size;
+    end_->store(std::uint64_t(used_), std::memory_order_release);
+  }
+
+ private:
+  static const std::size_t headerSize = 32;
+  static const std::size_t recordHeaderSize = 8;
+
+  static std::size_t padded(std::size_t size) { return (size + 7) / 8 * 8; }
+
+  // The end offset is read by other processes.
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2 &&
+                    sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t),
+                "the end offset must be a lock free uint64");
+
+  void openSegment() {
+#ifdef _WIN32
+    throw std::runtime_error("binary logs are not supported on Windows");
+#else
+    std::ostringstream filename;
+    filename << prefix_ << '.' << index_ << ".dglog";
+    int fd = ::open(filename.str().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw std::runtime_error("cannot open " + filename.str());
+#ifdef __linux__
+    bool allocated = ::posix_fallocate(fd, 0, off_t(segmentSize_)) == 0;
+#else
+    bool allocated = ::ftruncate(fd, off_t(segmentSize_)) == 0;
+#endif
+    void* data = allocated ? ::mmap(NULL, segmentSize_, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED, fd, 0)
+                           : MAP_FAILED;
+    ::close(fd);
+    if (data == MAP_FAILED)
+      throw std::runtime_error("cannot allocate " + filename.str());
+    data_ = static_cast<char*>(data);
+    std::uint64_t header[3] = {0, std::uint64_t(index_),
+                               std::uint64_t(segmentSize_)};
+    std::memcpy(header, "DGRTLOG1", 8);
+    std::memcpy(data_, header, sizeof(header));
+    end_ = new (data_ + 24) std::atomic<std::uint64_t>(headerSize);
+    used_ = headerSize;
+#endif
+  }
+
+  void closeSegment() {
+#ifndef _WIN32
+    if (data_ != NULL) ::munmap(data_, segmentSize_);
+#endif
+    data_ = NULL;
+    end_ = NULL;
+  }
+
+  std::string prefix_;
+  std::size_t segmentSize_;
+  std::size_t index_;
+  char* data_;
+  /// Last field of the header.
+  std::atomic<std::uint64_t>* end_;
+  std::size_t used_;
+};
+
+std::vector<boost::shared_ptr<BinaryLoggerStream> > binaryStreams_;
+
+/// Logger stream handing the messages to a Python callable, by batches.
+///
+/// The messages are queued by write, without the GIL, and a thread calls
+/// callback(list of messages) with one acquisition of the GIL per batch,
+/// when batchSize messages are queued or every period. The logger gives the
+/// text of the messages only, without their type or their entity.
+class PythonLoggerStream : public LoggerStream {
+ public:
+  PythonLoggerStream(bp::object callback, std::size_t batchSize,
+                     double period)
+      : callback_(callback.ptr()),
+        batchSize_(batchSize),
+        period_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double>(period))),
+        running_(true),
+        dropped_(0) {
+    if (batchSize_ == 0) throw std::invalid_argument("batch size must be > 0");
+    if (!(period > 0)) throw std::invalid_argument("period must be > 0");
+    Py_INCREF(callback_);
+    thread_ = std::thread(&PythonLoggerStream::loop, this);
+  }
+
+  ~PythonLoggerStream() {
+    stop();
+    // Without the interpreter, the callable is leaked.
+    if (callback_ != NULL && Py_IsInitialized()) {
+      ScopedGILEnsure gil;
+      Py_DECREF(callback_);
+    }
+  }
+
+  void write(const char* c) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    if (pending_.size() >= maxPending) {
+      ++dropped_;
+      return;
+    }
+    pending_.push_back(c);
+    if (pending_.size() >= batchSize_) wake_.notify_one();
+  }
+
+  /// Hand the queued messages to the callable and stop the thread.
+  /// Must be called with the GIL held.
+  void close() {
+    {
+      ScopedGILRelease nogil;
+      stop();
+    }
+    Py_XDECREF(callback_);
+    callback_ = NULL;
+    if (dropped_ > 0)
+      std::cerr << dropped_ << " messages were dropped by the Python output "
+                << "stream of the logger" << std::endl;
+  }
+
+ private:
+  static const std::size_t maxPending = 1 << 16;
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) return;
+      running_ = false;
+    }
+    wake_.notify_all();
+    thread_.join();
+  }
+
+  void loop() {
+    std::vector<std::string> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wake_.wait_for(lock, period_, [this] {
+        return !running_ || pending_.size() >= batchSize_;
+      });
+      batch.swap(pending_);
+      bool running = running_;
+      lock.unlock();
+      if (!batch.empty()) deliver(batch);
+      batch.clear();
+      lock.lock();
+      if (!running) break;
+    }
+  }
+
+  void deliver(const std::vector<std::string>& batch) {
+    if (!Py_IsInitialized()) return;
+    ScopedGILEnsure gil;
+    try {
+      bp::call<void>(callback_, to_py_list(batch.begin(), batch.end()));
+    } catch (const bp::error_already_set&) {
+      PyErr_Print();
+    }
+  }
+
+  PyObject* callback_;
+  std::size_t batchSize_;
+  std::chrono::nanoseconds period_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool running_;
+  std::vector<std::string> pending_;
+  std::size_t dropped_;
+};
+
+std::vector<boost::shared_ptr<PythonLoggerStream> > pythonStreams_;
+
+}  // namespace
+
+void addLoggerPythonOutputStream(bp::object callback, std::size_t batchSize,
+                                 double period) {
+  if (PyCallable_Check(callback.ptr()) == 0)
+    throw std::invalid_argument(obj_to_str(callback.ptr()) +
+                                " is not callable");
+  boost::shared_ptr<PythonLoggerStream> stream(
+      new PythonLoggerStream(callback, batchSize, period));
+  streamList().add(stream);
+  pythonStreams_.push_back(stream);
+}
+
+void closeLoggerPythonOutputStream() {
+  for (const auto& stream : pythonStreams_) {
+    streamList().remove(stream);
+    stream->close();
+  }
+  pythonStreams_.clear();
+}
+
+void addLoggerBinaryOutputStream(const char* prefix, std::size_t segmentSize) {
+  boost::shared_ptr<BinaryLoggerStream> stream(
+      new BinaryLoggerStream(prefix, segmentSize));
+  streamList().add(stream);
+  binaryStreams_.push_back(stream);
+}
+
+void closeLoggerBinaryOutputStream() {
+  // The segments are released by the streams once they are not written.
+  for (const auto& stream : binaryStreams_) streamList().remove(stream);
+  binaryStreams_.clear();
+}
+
 void addLoggerCoutOutputStream() { dgADD_OSTREAM_TO_RTLOG(std::cout); }
 
-void realTimeLoggerDestroy() { RealTimeLogger::destroy(); }
+namespace {
+
+/// Mutex of the consumer side of the RealTimeLogger, shared by the spinner
+/// and realTimeLoggerSpinOnce, since spinOnce must not run concurrently.
+std::mutex spinMutex_;
+
+/// Thread flushing the RealTimeLogger periodically.
+class LoggerSpinner {
+ public:
+  LoggerSpinner() : running_(false) { resetStats(); }
+  ~LoggerSpinner() { stop(); }
+
+  void start(std::size_t batchSize, double period,
+             const std::vector<int>& cpus) {
+    stop();
+    if (batchSize == 0) throw std::invalid_argument("batch size must be > 0");
+    if (!(period > 0)) throw std::invalid_argument("period must be > 0");
+#ifndef __linux__
+    if (!cpus.empty())
+      throw std::invalid_argument("CPU affinity is only supported on Linux");
+#endif
+    RealTimeLogger::instance();
+    resetStats();
+    batchSize_ = batchSize;
+    period_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(period));
+    running_ = true;
+    thread_ = std::thread(&LoggerSpinner::loop, this);
+#ifdef __linux__
+    if (!cpus.empty()) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (int cpu : cpus) CPU_SET(cpu, &set);
+      int error = pthread_setaffinity_np(thread_.native_handle(),
+                                         sizeof(set), &set);
+      if (error != 0) {
+        stop();
+        throw std::runtime_error("cannot set the CPU affinity: " +
+                                 std::string(std::strerror(error)));
+      }
+    }
+#endif
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) return;
+      running_ = false;
+    }
+    wake_.notify_all();
+    thread_.join();
+  }
+
+  bool running() const { return running_; }
+
+  bp::dict stats() const {
+    bp::dict d;
+    d["running"] = bool(running_);
+    d["queue_depth"] = realTimeLoggerQueueDepth();
+    d["max_queue_depth"] = maxDepth_.load();
+    d["flushed"] = flushed_.load();
+    d["batches"] = batches_.load();
+    d["full"] = full_.load();
+    d["last_latency"] = double(lastLatency_.load()) * 1e-9;
+    d["max_latency"] = double(maxLatency_.load()) * 1e-9;
+    std::uint64_t batches = batches_.load();
+    d["mean_latency"] =
+        batches > 0 ? double(totalLatency_.load()) * 1e-9 / double(batches)
+                    : 0.;
+    return d;
+  }
+
+ private:
+  static std::size_t realTimeLoggerQueueDepth() {
+    return RealTimeLogger::instance().size();
+  }
+
+  void resetStats() {
+    maxDepth_ = 0;
+    flushed_ = 0;
+    batches_ = 0;
+    full_ = 0;
+    lastLatency_ = 0;
+    maxLatency_ = 0;
+    totalLatency_ = 0;
+  }
 
-void realTimeLoggerSpinOnce() { RealTimeLogger::instance().spinOnce(); }
+  void loop() {
+    typedef std::chrono::steady_clock clock;
+    clock::time_point next = clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+      lock.unlock();
+      flush();
+      lock.lock();
+      next += period_;
+      wake_.wait_until(lock, next, [this] { return !running_; });
+    }
+    lock.unlock();
+    // Drain the messages left.
+    while (flush() == batchSize_) continue;
+  }
+
+  /// Write at most batchSize_ messages.
+  std::size_t flush() {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    RealTimeLogger& logger = RealTimeLogger::instance();
+    std::uint64_t depth = logger.size();
+    if (depth > maxDepth_) maxDepth_ = depth;
+    // While the buffer is full, the logger drops the new messages.
+    if (logger.full()) ++full_;
+    std::size_t n = 0;
+    {
+      std::lock_guard<std::mutex> lock(spinMutex_);
+      while (n < batchSize_ && logger.spinOnce()) ++n;
+    }
+    if (n == 0) return 0;
+    std::uint64_t latency = std::uint64_t(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    flushed_ += n;
+    ++batches_;
+    lastLatency_ = latency;
+    totalLatency_ += latency;
+    if (latency > maxLatency_) maxLatency_ = latency;
+    return n;
+  }
+
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::atomic<bool> running_;
+  std::size_t batchSize_;
+  std::chrono::nanoseconds period_;
+
+  std::atomic<std::uint64_t> maxDepth_;
+  std::atomic<std::uint64_t> flushed_;
+  std::atomic<std::uint64_t> batches_;
+  std::atomic<std::uint64_t> full_;
+  std::atomic<std::uint64_t> lastLatency_;
+  std::atomic<std::uint64_t> maxLatency_;
+  std::atomic<std::uint64_t> totalLatency_;
+};
+
+LoggerSpinner& spinner() {
+  static LoggerSpinner spinner;
+  return spinner;
+}
+
+}  // namespace
+
+void realTimeLoggerStartSpinner(std::size_t batchSize, double period,
+                                bp::object cpus) {
+  std::vector<int> affinity = to_std_vector<int>(cpus);
+  ScopedGILRelease nogil;
+  spinner().start(batchSize, period, affinity);
+}
+
+void realTimeLoggerStopSpinner() {
+  ScopedGILRelease nogil;
+  spinner().stop();
+}
+
+bp::dict realTimeLoggerStats() { return spinner().stats(); }
+
+void realTimeLoggerDestroy() {
+  {
+    ScopedGILRelease nogil;
+    spinner().stop();
+  }
+  RealTimeLogger::destroy();
+  streamList_.reset();
+}
+
+void realTimeLoggerSpinOnce() {
+  std::lock_guard<std::mutex> lock(spinMutex_);
+  RealTimeLogger::instance().spinOnce();
+}
 
 void realTimeLoggerInstance() { RealTimeLogger::instance(); }
 
@@ -23,8 +23,12 @@
 #include <sstream>
 
 #include "dynamic-graph/python/convert-dg-to-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/input-log.hh"
 #include "dynamic-graph/python/module.hh"
+#include "dynamic-graph/python/signal-handle.hh"
 #include "dynamic-graph/python/signal-wrapper.hh"
+#include "dynamic-graph/python/trace-file.hh"
 
 namespace dynamicgraph {
 namespace python {
@@ -33,14 +37,19 @@ namespace python {
    \brief plug a signal into another one.
 */
 void plug(SignalBase<int>* signalOut, SignalBase<int>* signalIn) {
+  ScopedGraphCall graphCall;
   signalIn->plug(signalOut);
 }
 
 void enableTrace(bool enable, const char* filename) {
   if (enable)
-    DebugTrace::openFile(filename);
+    trace::enable(filename);
   else
-    DebugTrace::closeFile(filename);
+    trace::disable();
+}
+
+void setTraceFilter(bp::object tokens) {
+  trace::setFilter(to_std_vector<std::string>(tokens));
 }
 
 }  // namespace python
@@ -53,21 +62,21 @@ typedef bp::return_value_policy<bp::manage_new_object> manage_new_object;
 typedef bp::return_value_policy<bp::reference_existing_object>
     reference_existing_object;
 
-typedef dg::PoolStorage::Entities MapOfEntities;
-
-struct MapOfEntitiesPairToPythonConverter {
-  static PyObject* convert(const MapOfEntities::value_type& pair) {
-    return bp::incref(bp::make_tuple(pair.first, bp::ptr(pair.second)).ptr());
-  }
-};
+/// View of the map of the entities of the pool, exposed as MapOfEntities.
+/// Its methods lock the map, or read the lists of pool::snapshot, so that it
+/// can be used from several threads.
+struct MapOfEntities {};
 
-MapOfEntities* getEntityMap() {
-  return const_cast<MapOfEntities*>(
-      &dg::PoolStorage::getInstance()->getEntityMap());
-}
+MapOfEntities getEntityMap() { return MapOfEntities(); }
 
+/// Signal of an entity, through the handle of its path, which keeps the
+/// signal found until the pool changes. The signals of an entity registered
+/// in the pool under another name than its own are read from the entity,
+/// which raises the error if there is no such signal.
 dg::SignalBase<int>* getSignal(dg::Entity& e, const std::string& name) {
-  return &e.getSignal(name);
+  dg::SignalBase<int>* signal =
+      dg::python::pool::signalHandle(e.getName() + "." + name).signalOf(e);
+  return signal != NULL ? signal : &e.getSignal(name);
 }
 
 class PythonEntity : public dg::Entity {
@@ -78,9 +87,11 @@ class PythonEntity : public dg::Entity {
 
   void signalRegistration(dg::SignalBase<int>& signal) {
     dg::Entity::signalRegistration(signal);
+    dg::python::pool::invalidate();
   }
   void signalDeregistration(const std::string& name) {
     dg::Entity::signalDeregistration(name);
+    dg::python::pool::invalidate();
   }
 };
 
@@ -161,21 +172,16 @@ void exposeEntityBase() {
           },
           "Print the list of signals into standard output: temporary.")
 
-      /*
-      .def("__getattr__", +[](Entity& e, const std::string &name) ->
-      SignalBase<int>* { return &e.getSignal(name); },
-          reference_existing_object())
-      def __getattr__(self, name):
-          try:
-              return self.signal(name)
-          except Exception:
-              try:
-                  object.__getattr__(self, name)
-              except AttributeError:
-                  raise AttributeError("'%s' entity has no attribute %s\n" %
-      (self.name, name) + '  entity attributes are usually either\n' + '    -
-      commands,\n' + '    - signals or,\n' + '    - user defined attributes')
-                                       */
+      .def("__getattr__", &dg::python::entity::getAttr,
+           "get a command or a signal of the entity by name")
+      .def("__dir__", &dg::python::entity::dir)
+      .setattr("_attribute_options",
+               python::AddCommands | python::AddSignals)
+      .def("add_commands", &dg::python::entity::addCommands,
+           "bind the commands as attributes of the object, ahead of the "
+           "methods of the same name")
+      .def("add_signals", &dg::python::entity::addSignals,
+           "bind the signals as attributes of the object")
       /*
       .def("__setattr__", +[](bp::object self, const std::string &name,
       bp::object value) { Entity& e = bp::extract<Entity&> (self); if
@@ -187,25 +193,10 @@ void exposeEntityBase() {
           })
           */
 
-      /* TODO ?
-      def boundNewCommand(self, cmdName):
-          """
-          At construction, all existing commands are bound directly in the
-      class. This method enables to bound new commands dynamically. These new
-      bounds are not made with the class, but directly with the object instance.
-          """
-      def boundAllNewCommands(self):
-          """
-          For all commands that are not attribute of the object instance nor of
-      the class, a new attribute of the instance is created to bound the
-      command.
-          """
-          */
-
       // For backward compat
       .add_static_property(
           "entities",
-          bp::make_function(&getEntityMap, reference_existing_object()));
+          &getEntityMap);
 
   python::exposeEntity<PythonEntity, bp::bases<Entity>, 0>()
       .def("signalRegistration", &PythonEntity::signalRegistration)
@@ -218,10 +209,23 @@ void exposeEntityBase() {
 
 void exposeCommand() {
   using dg::command::Command;
-  bp::class_<Command, boost::noncopyable>("Command", bp::no_init)
-      .def("__call__", bp::raw_function(dg::python::entity::executeCmd, 1),
-           "execute the command")
-      .add_property("__doc__", &Command::getDocstring);
+  bp::class_<Command, boost::noncopyable> obj("Command", bp::no_init);
+  obj.add_property("__doc__", &Command::getDocstring);
+#if PY_VERSION_HEX >= 0x03070000
+  // A method descriptor is called through vectorcall, without the overload
+  // resolution nor the argument tuple and dict of boost::python functions.
+  static PyMethodDef call = {
+      "__call__",
+      reinterpret_cast<PyCFunction>(
+          reinterpret_cast<void (*)(void)>(dg::python::entity::callCmd)),
+      METH_FASTCALL, "execute the command"};
+  obj.setattr("__call__",
+              bp::object(bp::handle<>(PyDescr_NewMethod(
+                  reinterpret_cast<PyTypeObject*>(obj.ptr()), &call))));
+#else
+  obj.def("__call__", bp::raw_function(dg::python::entity::executeCmd, 1),
+          "execute the command");
+#endif
 }
 
 void exposeOldAPI() {
@@ -229,11 +233,35 @@ void exposeOldAPI() {
           "plug an output signal into an input signal",
           (bp::arg("signalOut"), "signalIn"));
   bp::def("enableTrace", dynamicgraph::python::enableTrace,
-          "Enable or disable tracing debug info in a file");
+          "Enable or disable tracing debug info in a file",
+          (bp::arg("enable"),
+           bp::arg("filename") = dg::DebugTrace::DEBUG_FILENAME_DEFAULT));
+  bp::def("setTraceRotation", dynamicgraph::python::trace::setRotation,
+          "Rotate the trace file when it would grow over maxBytes, keeping\n"
+          "maxFiles files. maxBytes = 0 disables the rotation.",
+          (bp::arg("maxBytes"), bp::arg("maxFiles") = 2));
+  bp::def("setTraceFilter", dynamicgraph::python::setTraceFilter,
+          "Keep only the trace lines containing one of the given strings,\n"
+          "such as entity names. An empty list keeps all the lines.",
+          bp::arg("tokens"));
+  bp::def("writeTrace", dynamicgraph::python::trace::write,
+          "Write text to the trace file, as dgDEBUG does. Only the complete\n"
+          "lines are filtered and written.",
+          bp::arg("text"));
+  bp::def("flushTrace", dynamicgraph::python::trace::flush,
+          "Wait until the traces written so far are in the file");
   // Signals
   bp::def("create_signal_wrapper",
           dynamicgraph::python::signalBase::createSignalWrapper,
           reference_existing_object(), "create a SignalWrapper C++ object");
+  bp::def("string_to_array", dynamicgraph::python::convert::stringToArray,
+          "read the text \"[n](x_1,...)\" of a vector or \"[n,m]((x_11,...),"
+          "...)\"\nof a matrix into a numpy array, without loss of precision",
+          bp::arg("text"));
+  bp::def("array_to_string", dynamicgraph::python::convert::arrayToString,
+          "write a number, a vector or a matrix in the format read by\n"
+          "string_to_array, with the digits needed to read it back exactly",
+          bp::arg("array"));
   // Entity
   bp::def("factory_get_entity_class_list",
           dynamicgraph::python::factory::getEntityClassList,
@@ -251,6 +279,28 @@ void exposeOldAPI() {
   bp::def("closeLoggerFileOutputStream",
           dynamicgraph::python::debug::closeLoggerFileOutputStream,
           "close all the loggers file output streams.");
+  bp::def("addLoggerBinaryOutputStream",
+          dynamicgraph::python::debug::addLoggerBinaryOutputStream,
+          "add an output stream to the logger, writing binary records to\n"
+          "memory mapped segments prefix.<index>.dglog of segmentSize bytes.\n"
+          "See dynamic_graph.rt_log to read them.",
+          (bp::arg("prefix"), bp::arg("segmentSize") = 1 << 24));
+  bp::def("closeLoggerBinaryOutputStream",
+          dynamicgraph::python::debug::closeLoggerBinaryOutputStream,
+          "remove the binary output streams from the logger and release\n"
+          "their segments.");
+  bp::def("addLoggerPythonOutputStream",
+          dynamicgraph::python::debug::addLoggerPythonOutputStream,
+          "add an output stream to the logger, calling\n"
+          "callback(list of messages) from a thread, when batchSize\n"
+          "messages are queued or every period seconds.\n"
+          "See dynamic_graph.logging_bridge.",
+          (bp::arg("callback"), bp::arg("batchSize") = 256,
+           bp::arg("period") = 1e-2));
+  bp::def("closeLoggerPythonOutputStream",
+          dynamicgraph::python::debug::closeLoggerPythonOutputStream,
+          "remove the Python output streams from the logger, and hand the\n"
+          "queued messages to their callbacks.");
   bp::def("real_time_logger_destroy",
           dynamicgraph::python::debug::realTimeLoggerDestroy,
           "Destroy the real time logger.");
@@ -260,6 +310,169 @@ void exposeOldAPI() {
   bp::def("real_time_logger_instance",
           dynamicgraph::python::debug::realTimeLoggerInstance,
           "Starts the real time logger.");
+  bp::def("real_time_logger_start_spinner",
+          dynamicgraph::python::debug::realTimeLoggerStartSpinner,
+          "start a thread writing at most batch_size messages of the real\n"
+          "time logger every period seconds, on the given CPUs.",
+          (bp::arg("batch_size") = 64, bp::arg("period") = 1e-3,
+           bp::arg("cpus") = bp::list()));
+  bp::def("real_time_logger_stop_spinner",
+          dynamicgraph::python::debug::realTimeLoggerStopSpinner,
+          "write the messages left and stop the thread started by\n"
+          "real_time_logger_start_spinner.");
+  bp::def("real_time_logger_stats",
+          dynamicgraph::python::debug::realTimeLoggerStats,
+          "counters of the spinner thread: queue depth, messages written,\n"
+          "batches, number of times the buffer was found full (new messages\n"
+          "are then dropped) and flush latencies in seconds.");
+}
+
+void exposePool() {
+  bp::def("create_entities", dynamicgraph::python::pool::createEntities,
+          "create entities from a list of (className, name).\n"
+          "Return the list of errors as (index, message).",
+          bp::arg("entities"));
+  bp::def("plug_many", dynamicgraph::python::pool::plugMany,
+          "plug signals from a list of (signalOut, signalIn), where signals\n"
+          "are objects or paths \"entity.signal\".\n"
+          "Return the list of errors as (index, message).",
+          bp::arg("plugs"));
+
+  using dynamicgraph::python::pool::SignalHandle;
+  bp::class_<SignalHandle, boost::noncopyable>(
+      "SignalHandle",
+      "Signal designated by a path \"entity.signal\", looked up in the\n"
+      "pool at each access.",
+      bp::no_init)
+      .add_property("path",
+                    bp::make_function(&SignalHandle::path,
+                                      bp::return_value_policy<
+                                          bp::copy_const_reference>()))
+      .add_property("signal",
+                    bp::make_function(&SignalHandle::signal,
+                                      reference_existing_object()))
+      .add_property("valid", &SignalHandle::valid);
+  bp::def(
+      "signal_handle",
+      +[](const std::string& path) {
+        // Never deleted, as the objects cannot outlive the interpreter.
+        static bp::dict* handles = new bp::dict;
+        bp::object handle = handles->get(path);
+        if (handle.is_none()) {
+          handle = bp::object(
+              bp::ptr(&dynamicgraph::python::pool::signalHandle(path)));
+          (*handles)[path] = handle;
+        }
+        return handle;
+      },
+      "the handle of a path \"entity.signal\". There is a single handle\n"
+      "per path.",
+      bp::arg("path"));
+  bp::def("resolve_signal", dynamicgraph::python::pool::resolveSignal,
+          reference_existing_object(),
+          "the signal designated by a path \"entity.signal\".",
+          bp::arg("path"));
+  bp::def(
+      "match_signals",
+      +[](const std::string& entity, const std::string& signal, bool regex) {
+        bp::list paths;
+        for (const std::string& path :
+             dynamicgraph::python::pool::matchSignals(entity, signal, regex))
+          paths.append(path);
+        return paths;
+      },
+      "the paths \"entity.signal\" of the signals of the pool whose entity\n"
+      "and signal names match glob patterns, or regular expressions if\n"
+      "regex is True.",
+      (bp::arg("entity"), bp::arg("signal") = "*", bp::arg("regex") = false));
+  bp::def("save_state", dynamicgraph::python::pool::saveState,
+          "write the entities of the pool, the plugs and the constant values\n"
+          "of the signals to a binary file.",
+          bp::arg("path"));
+  bp::def("load_state", dynamicgraph::python::pool::loadState,
+          "restore a file written by save_state: create the missing\n"
+          "entities, set the constant values and plug the signals.\n"
+          "Return the list of errors as (index, message).",
+          bp::arg("path"));
+  bp::def("notify_pool_changed", dynamicgraph::python::pool::invalidate,
+          "notify the bindings that entities or signals were created or\n"
+          "removed from C++, so that the cached lookups are redone.");
+}
+
+void exposeGraph() {
+  bp::def("run", dynamicgraph::python::graph::run,
+          (bp::arg("outputs"), bp::arg("t0"), bp::arg("n_steps"),
+           bp::arg("record") = bp::tuple(), bp::arg("out") = bp::object(),
+           bp::arg("threads") = 0),
+          "recompute the output signals at times t0, ..., t0 + n_steps - 1.\n"
+          "The signals of record are read after each time, and their values\n"
+          "returned as arrays of shape (n_steps,) for scalars and\n"
+          "(n_steps, size) for vectors. If out is given, the values are\n"
+          "written to its arrays instead.\n"
+          "With threads > 1, the outputs whose dependency cones share\n"
+          "neither a signal nor an entity are recomputed in parallel.");
+  bp::def("start_input_recording", dynamicgraph::python::inputLog::start,
+          (bp::arg("filename"), bp::arg("time") = 0),
+          "write the values set from now on to the signals, by their\n"
+          "property value, to a binary log replayed by replay. A value is\n"
+          "logged with the time of the first recomputation it can change:\n"
+          "time until a signal is recomputed by recompute or run, then one\n"
+          "after the last time recomputed.");
+  bp::def("stop_input_recording", dynamicgraph::python::inputLog::stop,
+          "close the log of the values set to the signals, and return the\n"
+          "number of values written.");
+  bp::def("replay", dynamicgraph::python::graph::replay,
+          (bp::arg("filename"), bp::arg("outputs"), bp::arg("t0"),
+           bp::arg("n_steps"), bp::arg("record") = bp::tuple(),
+           bp::arg("out") = bp::object(), bp::arg("threads") = 0),
+          "same as run, setting before recomputing the outputs at time t\n"
+          "the values of the log written by start_input_recording of time\n"
+          "t or before.");
+  bp::def("disjoint_cones", dynamicgraph::python::graph::cones,
+          "group the indices of the outputs into lists whose dependency\n"
+          "cones share neither a signal nor an entity.",
+          bp::arg("outputs"));
+  bp::def("dependency_graph", dynamicgraph::python::graph::dependencyGraph,
+          "the dependency graph of the signals of the pool, as a dict of\n"
+          "  - lists entity, signal and type, and array time, per node,\n"
+          "  - arrays indptr and indices, such that node i depends on the\n"
+          "    nodes indices[indptr[i]:indptr[i + 1]].");
+  bp::def("watch_signal", dynamicgraph::python::monitor::watch,
+          "call callback (value) when the value of a signal, given as an\n"
+          "object or a path \"entity.signal\", changes by more than\n"
+          "tolerance. The values are compared by the thread started by\n"
+          "start_monitor, while the signal is registered under its path.\n"
+          "Return an identifier for unwatch_signal.",
+          (bp::arg("signal"), bp::arg("callback"), bp::arg("tolerance") = 0.));
+  bp::def("unwatch_signal", dynamicgraph::python::monitor::unwatch,
+          "stop calling the callback of watch_signal", bp::arg("id"));
+  bp::def("start_monitor", dynamicgraph::python::monitor::start,
+          "start comparing the values of the watched signals every period\n"
+          "seconds, without recomputing them. The changes are delivered in\n"
+          "batches by another thread, only the last one of each signal.",
+          bp::arg("period") = 0.02);
+  bp::def("stop_monitor", dynamicgraph::python::monitor::stop,
+          "stop the threads of start_monitor");
+  bp::def("monitor_stats", dynamicgraph::python::monitor::stats,
+          "counters of the monitor: watched, pending, polls, changes,\n"
+          "coalesced and batches");
+  bp::def("aio_fd", dynamicgraph::python::aio::fd,
+          "file descriptor readable once some waits of aio_wait_time are\n"
+          "over, for the reader of an event loop. See dynamic_graph.aio.");
+  bp::def("aio_wait_time", dynamicgraph::python::aio::waitTime,
+          "wait, from a thread, until a signal, given as an object or a path\n"
+          "\"entity.signal\", is computed at time or later. The signal is\n"
+          "looked up by its path each time. Return an identifier returned\n"
+          "by aio_ready once the wait is over.",
+          (bp::arg("signal"), bp::arg("time")));
+  bp::def("aio_cancel", dynamicgraph::python::aio::cancel,
+          "cancel a wait of aio_wait_time", bp::arg("id"));
+  bp::def("aio_ready", dynamicgraph::python::aio::ready,
+          "the identifiers of the waits over since the last call");
+  bp::def("aio_set_period", dynamicgraph::python::aio::setPeriod,
+          "period, in seconds, at which the times of the awaited signals\n"
+          "are compared, while there are any. 1 ms by default.",
+          bp::arg("period"));
 }
 
 void enableEigenPy() {
@@ -275,43 +488,48 @@ void enableEigenPy() {
 
 BOOST_PYTHON_MODULE(wrap) {
   enableEigenPy();
+  // Raise again the Python errors carried across threads.
+  bp::register_exception_translator<dg::python::PythonError>(
+      +[](const dg::python::PythonError& error) { error.restore(); });
 
   exposeOldAPI();
+  exposePool();
+  exposeGraph();
 
   dg::python::exposeSignals();
   exposeEntityBase();
   exposeCommand();
 
-  typedef dg::PoolStorage::Entities MapOfEntities;
-  bp::class_<MapOfEntities>("MapOfEntities")
-      .def("__len__", &MapOfEntities::size)
+  bp::class_<MapOfEntities>("MapOfEntities", bp::no_init)
+      .def("__len__",
+           +[](const MapOfEntities&) { return dg::python::pool::size(); })
       .def(
           "keys",
-          +[](const MapOfEntities& m) -> bp::tuple {
-            bp::list res;
-            for (const auto& el : m) res.append(el.first);
-            return bp::tuple(res);
-          })
+          +[](const MapOfEntities&) { return dg::python::pool::entityNames(); })
+      .def("values",
+           +[](const MapOfEntities&) { return dg::python::pool::entities(); })
+      .def("items",
+           +[](const MapOfEntities&) { return dg::python::pool::items(); })
       .def(
-          "values",
-          +[](const MapOfEntities& m) -> bp::tuple {
-            bp::list res;
-            for (const auto& el : m) res.append(bp::ptr(el.second));
-            return bp::tuple(res);
+          "__getitem__",
+          +[](const MapOfEntities&, const std::string& n) {
+            return dg::python::pool::getEntity(n);
+          },
+          reference_existing_object())
+      .def(
+          "__setitem__",
+          +[](const MapOfEntities&, const std::string& n, dg::Entity* e) {
+            dg::python::pool::addEntity(n, e);
           })
-      .def("__getitem__",
-           static_cast<dg::Entity*& (MapOfEntities::*)(const std::string& k)>(
-               &MapOfEntities::at),
-           reference_existing_object())
       .def(
-          "__setitem__", +[](MapOfEntities& m, const std::string& n,
-                             dg::Entity* e) { m.emplace(n, e); })
-      .def("__iter__", bp::iterator<MapOfEntities>())
+          "__iter__",
+          +[](const MapOfEntities&) {
+            return bp::object(bp::handle<>(
+                PyObject_GetIter(dg::python::pool::items().ptr())));
+          })
       .def(
           "__contains__",
-          +[](const MapOfEntities& m, const std::string& n) -> bool {
-            return m.count(n);
+          +[](const MapOfEntities&, const std::string& n) {
+            return dg::python::pool::hasEntity(n);
           });
-  bp::to_python_converter<MapOfEntities::value_type,
-                          MapOfEntitiesPairToPythonConverter>();
 }
@@ -8,9 +8,15 @@
 #include <dynamic-graph/value.h>
 
 #include <iostream>
+#include <memory>
+#include <shared_mutex>
+#include <sstream>
 
 #include "dynamic-graph/python/convert-dg-to-py.hh"
 #include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/module.hh"
+#include "dynamic-graph/python/signal-handle.hh"
 
 // Ignore "dereferencing type-punned pointer will break strict-aliasing rules"
 // warnings on gcc caused by Py_RETURN_TRUE and Py_RETURN_FALSE.
@@ -51,11 +57,126 @@ void addSignals(bp::object obj) {
     obj.attr(el.first.c_str()) = bp::object(bp::ptr(el.second));
 }
 
+namespace {
+
+/// Python object of a member of an entity, created at the first lookup on
+/// the Python object \c obj of the entity, so that the following ones return
+/// the same object. It is created again when the member was replaced.
+template <typename T>
+bp::object member(bp::object obj, const std::string& name, T* member) {
+  static const char* const key = "_entity_members";
+  bp::dict dict = bp::extract<bp::dict>(obj.attr("__dict__"));
+  if (!dict.has_key(key)) dict[key] = bp::dict();
+  bp::dict members = bp::extract<bp::dict>(dict[key]);
+  bp::object cached = members.get(name);
+  if (!cached.is_none()) {
+    bp::extract<T*> p(cached);
+    if (p.check() && p() == member) return cached;
+  }
+  bp::object o(bp::ptr(member));
+  members[name] = o;
+  return o;
+}
+
+/// Kind of the members in the name table of a class.
+enum MemberKind { SIGNAL = 1, COMMAND = 2 };
+
+/// Table of the names of the members resolved on the objects of the class
+/// of obj, to their MemberKind, kept in the __dict__ of the class itself.
+/// The entities of a class usually have the same members: the table tells
+/// which map of the entity to read, and is checked against it.
+bp::dict classMembers(bp::object obj) {
+  static PyObject* const key = PyUnicode_InternFromString("_entity_names");
+  PyTypeObject* type = Py_TYPE(obj.ptr());
+  PyObject* table = PyDict_GetItem(type->tp_dict, key);
+  if (table != NULL) return bp::dict(bp::handle<>(bp::borrowed(table)));
+  bp::dict created;
+  if (PyObject_SetAttr(reinterpret_cast<PyObject*>(type), key,
+                       created.ptr()) != 0)
+    bp::throw_error_already_set();
+  return created;
+}
+
+SignalBase<int>* findSignal(const Entity& entity, const std::string& name) {
+  const auto& signals = entity.getSignalMap();
+  auto it = signals.find(name);
+  return it != signals.end() ? it->second : NULL;
+}
+
+Command* findCommand(Entity& entity, const std::string& name) {
+  const auto& commands = entity.getNewStyleCommandMap();
+  auto it = commands.find(name);
+  return it != commands.end() ? it->second : NULL;
+}
+
+}  // namespace
+
+/// \param obj an Entity object
+/// \param name the name of a signal or a command of the entity
+///
+/// Python calls this method only when the regular attribute lookup fails, so
+/// that the commands and signals need not be bound at construction. Signals
+/// registered after the construction are resolved as well. Only the members
+/// selected by the Options of exposeEntity, read from the class attribute
+/// _attribute_options, are resolved.
+bp::object getAttr(bp::object obj, const std::string& name) {
+  Entity& entity = bp::extract<Entity&>(obj);
+  const int options = bp::extract<int>(obj.attr("_attribute_options"));
+  bp::dict names = classMembers(obj);
+  const bp::object known = names.get(name);
+  // A name of a command in the table is looked up in the commands only,
+  // the others in the signals, then in the commands.
+  if ((options & AddCommands) && !known.is_none() &&
+      bp::extract<int>(known)() == COMMAND) {
+    if (Command* command = findCommand(entity, name))
+      return member(obj, name, command);
+  }
+  if (options & AddSignals) {
+    if (SignalBase<int>* signal = findSignal(entity, name)) {
+      if (known.is_none()) names[name] = int(SIGNAL);
+      return member(obj, name, signal);
+    }
+  }
+  if (options & AddCommands) {
+    if (Command* command = findCommand(entity, name)) {
+      names[name] = int(COMMAND);
+      return member(obj, name, command);
+    }
+  }
+  PyErr_SetString(PyExc_AttributeError,
+                  ("'" + entity.getName() + "' entity has no attribute " +
+                   name + "\n  entity attributes are usually either\n" +
+                   "    - commands,\n    - signals or,\n" +
+                   "    - user defined attributes")
+                      .c_str());
+  bp::throw_error_already_set();
+  return bp::object();
+}
+
+/// \param obj an Entity object
+/// \return the attributes of the object and the names of the commands and
+///         signals of the entity resolved by getAttr.
+bp::list dir(bp::object obj) {
+  Entity& entity = bp::extract<Entity&>(obj);
+  const int options = bp::extract<int>(obj.attr("_attribute_options"));
+  bp::object objectDir =
+      bp::object(bp::handle<>(bp::borrowed(&PyBaseObject_Type)))
+          .attr("__dir__");
+  bp::list ret(objectDir(obj));
+  if (options & AddCommands)
+    for (const auto& el : entity.getNewStyleCommandMap()) ret.append(el.first);
+  if (options & AddSignals)
+    for (const auto& el : entity.getSignalMap()) ret.append(el.first);
+  return ret;
+}
+
 /**
    \brief Create an instance of Entity
+   Called without the GIL and with the graph locked, see ScopedGraphCall.
 */
 Entity* create(const char* className, const char* instanceName) {
   Entity* obj = NULL;
+  std::unique_lock<std::shared_timed_mutex> write(pool::poolMutex());
   /* Try to find if the corresponding object already exists. */
   if (dynamicgraph::PoolStorage::getInstance()->existEntity(instanceName,
                                                             obj)) {
@@ -71,22 +192,113 @@ Entity* create(const char* className, const char* instanceName) {
   {
     obj = dynamicgraph::FactoryStorage::getInstance()->newEntity(
         std::string(className), std::string(instanceName));
+    pool::invalidate();
   }
 
   return obj;
 }
 
+namespace {
+
+/// Argument converters and parameter storage of a command, built at the
+/// first call through a Python object of the command and kept in the
+/// __dict__ of the object, so that they live as long as it does. The
+/// following calls neither dispatch on the value types nor reallocate the
+/// vector of values.
+struct CommandCall {
+  explicit CommandCall(const Command& command) : command(&command), calls(0) {
+    for (const auto& type : command.valueTypes())
+      appenders.push_back(convert::valueAppender(type));
+    values.reserve(appenders.size());
+  }
+
+  const Command* command;
+  std::vector<convert::ValueAppender> appenders;
+  std::vector<Value> values;
+  /// Number of calls in progress, from Python code run by a conversion or
+  /// from other threads while the GIL is released.
+  int calls;
+};
+
+void deleteCommandCall(PyObject* capsule) {
+  delete static_cast<CommandCall*>(PyCapsule_GetPointer(capsule, NULL));
+}
+
+/// \return the converters of command, kept by its Python object self, or
+///         NULL if self has no __dict__ or holds those of another command.
+CommandCall* commandCall(PyObject* self, const Command& command) {
+  static PyObject* const key = PyUnicode_InternFromString("_command_call");
+  bp::handle<> dict(bp::allow_null(PyObject_GenericGetDict(self, NULL)));
+  if (!dict) {
+    PyErr_Clear();
+    return NULL;
+  }
+  PyObject* capsule = PyDict_GetItem(dict.get(), key);
+  if (capsule != NULL) {
+    CommandCall* call =
+        static_cast<CommandCall*>(PyCapsule_GetPointer(capsule, NULL));
+    return call->command == &command ? call : NULL;
+  }
+  std::unique_ptr<CommandCall> call(new CommandCall(command));
+  bp::handle<> created(PyCapsule_New(call.get(), NULL, &deleteCommandCall));
+  call.release();
+  if (PyDict_SetItem(dict.get(), key, created.get()) != 0)
+    bp::throw_error_already_set();
+  return static_cast<CommandCall*>(PyCapsule_GetPointer(created.get(), NULL));
+}
+
+/// \param cached the converters of command, or NULL to build them.
+bp::object invoke(Command& command, CommandCall* cached,
+                  PyObject* const* args, Py_ssize_t nargs) {
+  std::unique_ptr<CommandCall> built;
+  if (cached == NULL) built.reset(new CommandCall(command));
+  CommandCall& call = cached != NULL ? *cached : *built;
+  if (nargs != Py_ssize_t(call.appenders.size())) {
+    std::ostringstream oss;
+    oss << "Wrong number of arguments: expected " << call.appenders.size()
+        << ", got " << nargs;
+    throw std::out_of_range(oss.str());
+  }
+  // The values are converted in place, without intermediate Python objects,
+  // into the storage of the command unless a call is in progress.
+  std::vector<Value> local;
+  std::vector<Value>& values = call.calls == 0 ? call.values : local;
+  values.clear();
+  ++call.calls;
+  Value result;
+  try {
+    for (Py_ssize_t i = 0; i < nargs; ++i)
+      call.appenders[std::size_t(i)](values, args[i]);
+    // The parameters are set with the graph locked, as another thread may
+    // call the command as soon as the GIL is released.
+    ScopedGraphCall graphCall;
+    command.setParameterValues(values);
+    result = command.execute();
+  } catch (...) {
+    --call.calls;
+    throw;
+  }
+  --call.calls;
+  return convert::fromValue(result);
+}
+
+}  // namespace
+
 bp::object executeCmd(bp::tuple args, bp::dict) {
   Command& command = bp::template extract<Command&>(args[0]);
-  if (bp::len(args) != int(command.valueTypes().size() + 1))
-    // TODO Put expected and given number of args
-    throw std::out_of_range("Wrong number of arguments");
-  std::vector<Value> values;
-  values.reserve(command.valueTypes().size());
-  for (int i = 1; i < bp::len(args); ++i)
-    values.push_back(convert::toValue(args[i], command.valueTypes()[i - 1]));
-  command.setParameterValues(values);
-  return convert::fromValue(command.execute());
+  return invoke(command, commandCall(bp::object(args[0]).ptr(), command),
+                PySequence_Fast_ITEMS(args.ptr()) + 1, bp::len(args) - 1);
+}
+
+PyObject* callCmd(PyObject* self, PyObject* const* args, Py_ssize_t nargs) {
+  try {
+    Command& command = bp::extract<Command&>(self);
+    return bp::incref(
+        invoke(command, commandCall(self, command), args, nargs).ptr());
+  } catch (...) {
+    bp::handle_exception();
+    return NULL;
+  }
 }
 
 }  // namespace entity
@@ -18,9 +18,19 @@ namespace factory {
    \brief Get name of entity
 */
 bp::tuple getEntityClassList() {
+  // Never deleted, as the tuple cannot outlive the interpreter.
+  static std::vector<std::string> cachedNames;
+  static bp::tuple* cached = NULL;
+
   std::vector<std::string> classNames;
   dynamicgraph::FactoryStorage::getInstance()->listEntities(classNames);
-  return to_py_tuple(classNames.begin(), classNames.end());
+  // The tuple is built again only when a plugin registered new classes.
+  if (cached == NULL || classNames != cachedNames) {
+    if (cached == NULL) cached = new bp::tuple;
+    *cached = to_py_tuple(classNames.begin(), classNames.end());
+    cachedNames.swap(classNames);
+  }
+  return *cached;
 }
 
 }  // namespace factory
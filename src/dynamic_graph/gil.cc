@@ -0,0 +1,91 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "dynamic-graph/python/gil.hh"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace dynamicgraph {
+namespace python {
+
+std::recursive_mutex& graphMutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+namespace {
+
+/// Number of ScopedGraphAccess waiting for the graph.
+std::atomic<int> graphWaiters(0);
+
+}  // namespace
+
+ScopedGraphAccess::ScopedGraphAccess() {
+  if (graphMutex().try_lock()) return;
+  ++graphWaiters;
+  {
+    ScopedGILRelease nogil;
+    graphMutex().lock();
+  }
+  --graphWaiters;
+}
+
+void yieldGraph() {
+  if (graphWaiters.load() == 0) return;
+  // The graph may be locked more than once by this thread, in which case
+  // the waiters cannot take it: the wait is bounded.
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+  graphMutex().unlock();
+  while (graphWaiters.load() > 0 && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::yield();
+  graphMutex().lock();
+}
+
+/// References to the exception, released with the GIL from any thread.
+struct PythonError::Error {
+  PyObject* type;
+  PyObject* value;
+  PyObject* traceback;
+  std::string message;
+
+  Error() {
+    PyErr_Fetch(&type, &value, &traceback);
+    PyErr_NormalizeException(&type, &value, &traceback);
+    PyObject* str = type != NULL ? PyObject_Str(value) : NULL;
+    const char* text = str != NULL ? PyUnicode_AsUTF8(str) : NULL;
+    message = text != NULL ? text : "the Python error was lost";
+    Py_XDECREF(str);
+    PyErr_Clear();
+  }
+  ~Error() {
+    ScopedGILEnsure gil;
+    Py_XDECREF(type);
+    Py_XDECREF(value);
+    Py_XDECREF(traceback);
+  }
+};
+
+PythonError::PythonError() : PythonError(std::make_shared<Error>()) {}
+
+PythonError::PythonError(const std::shared_ptr<Error>& error)
+    : std::runtime_error(error->message), error_(error) {}
+
+void PythonError::restore() const {
+  if (error_->type == NULL) {
+    PyErr_SetString(PyExc_RuntimeError, what());
+    return;
+  }
+  Py_INCREF(error_->type);
+  Py_XINCREF(error_->value);
+  Py_XINCREF(error_->traceback);
+  PyErr_Restore(error_->type, error_->value, error_->traceback);
+}
+
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,545 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include <dynamic-graph/entity.h>
+#include <dynamic-graph/pool.h>
+#include <dynamic-graph/signal-base.h>
+#include <dynamic-graph/time-dependency.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "dynamic-graph/python/convert-dg-to-py.hh"
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/input-log.hh"
+#include "dynamic-graph/python/recorder.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+#include "dynamic-graph/python/signal-wrapper.hh"
+
+namespace dynamicgraph {
+namespace python {
+namespace graph {
+
+namespace {
+
+/// Writable C contiguous buffer of doubles provided by the caller.
+class OutBuffer {
+ public:
+  /// \param rows expected number of rows
+  /// \param vector whether a two dimensional array is expected, of any
+  ///        number of columns checked later by checkColumns.
+  OutBuffer(PyObject* o, Py_ssize_t rows, bool vector) {
+    if (PyObject_GetBuffer(o, &view_, PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE |
+                                          PyBUF_FORMAT) != 0)
+      bp::throw_error_already_set();
+    if (std::string(view_.format) != "d" || view_.ndim != (vector ? 2 : 1) ||
+        view_.shape[0] != rows) {
+      PyBuffer_Release(&view_);
+      throw std::invalid_argument(
+          "expected an array of doubles of shape (" + std::to_string(rows) +
+          (vector ? ", size)" : ")"));
+    }
+  }
+  ~OutBuffer() { PyBuffer_Release(&view_); }
+
+  /// \throw std::invalid_argument if the array has not cols columns.
+  void checkColumns(Py_ssize_t cols) const {
+    if (view_.shape[1] != cols)
+      throw std::invalid_argument(
+          "expected an array of doubles of shape (" +
+          std::to_string(view_.shape[0]) + ", " + std::to_string(cols) + ")");
+  }
+
+  double* data() const { return static_cast<double*>(view_.buf); }
+
+ private:
+  OutBuffer(const OutBuffer&);
+  OutBuffer& operator=(const OutBuffer&);
+
+  Py_buffer view_;
+};
+
+/// Signals the value of signal is computed from: the signal it is plugged
+/// into, and the dependencies of a time dependent signal.
+void dependencies(const SignalBase<int>* signal,
+                  std::vector<const SignalBase<int>*>& deps) {
+  if (signal->isPlugged()) {
+    const SignalBase<int>* plugged = signal->getPluged();
+    if (plugged != NULL && plugged != signal) deps.push_back(plugged);
+  }
+  const TimeDependency<int>* timeDependency =
+      dynamic_cast<const TimeDependency<int>*>(signal);
+  if (timeDependency != NULL)
+    deps.insert(deps.end(), timeDependency->dependencies.begin(),
+                timeDependency->dependencies.end());
+}
+
+/// Text between the parentheses of the field of a signal name
+/// "ClassName(entityName)::input(type)::name", or an empty string.
+std::string nameField(const SignalBase<int>* signal, std::size_t field) {
+  const std::string& name = signal->getName();
+  std::string::size_type begin = 0;
+  for (std::size_t i = 0; i <= field; ++i) {
+    begin = name.find('(', begin);
+    if (begin == std::string::npos) return std::string();
+    ++begin;
+  }
+  std::string::size_type end = name.find(")::", begin);
+  if (end == std::string::npos) return std::string();
+  return name.substr(begin, end - begin);
+}
+
+std::string entityName(const SignalBase<int>* signal) {
+  return nameField(signal, 0);
+}
+
+std::string typeName(const SignalBase<int>* signal) {
+  return nameField(signal, 1);
+}
+
+/// Name of a signal without its prefix "ClassName(entityName)::input(type)::"
+std::string shortName(const SignalBase<int>* signal) {
+  const std::string& name = signal->getName();
+  std::string::size_type begin = name.rfind("::");
+  return begin == std::string::npos ? name : name.substr(begin + 2);
+}
+
+/// Partition of the outputs into groups whose dependency cones share
+/// neither a signal nor an entity, as the state of an entity may be shared
+/// by its signals. Groups and the outputs in them keep the order of outputs.
+/// \param python if not NULL, set to whether the cones of each group have
+///        a signal computed by Python.
+std::vector<std::vector<std::size_t> > disjointCones(
+    const std::vector<SignalBase<int>*>& outputs,
+    std::vector<bool>* python = NULL) {
+  // Union-find over the outputs.
+  std::vector<std::size_t> parent(outputs.size());
+  for (std::size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+  std::function<std::size_t(std::size_t)> find = [&](std::size_t i) {
+    return parent[i] == i ? i : parent[i] = find(parent[i]);
+  };
+  auto merge = [&](std::size_t i, std::size_t j) {
+    i = find(i);
+    j = find(j);
+    if (i != j) parent[std::max(i, j)] = std::min(i, j);
+  };
+
+  std::unordered_map<const SignalBase<int>*, std::size_t> signalOwner;
+  std::unordered_map<std::string, std::size_t> entityOwner;
+  std::vector<bool> wrapped(outputs.size(), false);
+  std::vector<const SignalBase<int>*> stack;
+  for (std::size_t i = 0; i < outputs.size(); ++i) {
+    stack.assign(1, outputs[i]);
+    while (!stack.empty()) {
+      const SignalBase<int>* signal = stack.back();
+      stack.pop_back();
+      auto inserted = signalOwner.insert(std::make_pair(signal, i));
+      if (!inserted.second) {
+        // Already reached, from this cone or from a previous one.
+        merge(i, inserted.first->second);
+        continue;
+      }
+      std::string entity = entityName(signal);
+      if (!entity.empty()) {
+        auto owner = entityOwner.insert(std::make_pair(entity, i));
+        if (!owner.second) merge(i, owner.first->second);
+      }
+      if (python != NULL && isSignalWrapper(signal)) wrapped[i] = true;
+      dependencies(signal, stack);
+    }
+  }
+
+  std::vector<std::vector<std::size_t> > groups;
+  std::map<std::size_t, std::size_t> groupOf;
+  if (python != NULL) python->clear();
+  for (std::size_t i = 0; i < outputs.size(); ++i) {
+    auto group = groupOf.insert(std::make_pair(find(i), groups.size()));
+    if (group.second) {
+      groups.push_back(std::vector<std::size_t>());
+      if (python != NULL) python->push_back(false);
+    }
+    groups[group.first->second].push_back(i);
+    if (python != NULL && wrapped[i]) (*python)[group.first->second] = true;
+  }
+  return groups;
+}
+
+/// Pool of threads running the tasks of a batch, where each thread takes the
+/// tasks of its own queue first, then steals the tasks left in the queues of
+/// the others.
+class TaskPool {
+ public:
+  explicit TaskPool(std::size_t nThreads)
+      : queues_(nThreads), generation_(0), stop_(false), remaining_(0) {
+    // The calling thread is the worker 0.
+    for (std::size_t i = 1; i < nThreads; ++i)
+      threads_.emplace_back(&TaskPool::loop, this, i);
+  }
+
+  ~TaskPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    start_.notify_all();
+    for (std::thread& thread : threads_) thread.join();
+  }
+
+  std::size_t size() const { return queues_.size(); }
+
+  /// Call f(i) for i in [0, n) and return when all calls returned.
+  /// \throw the exception of the lowest i whose call failed.
+  void run(std::size_t n, const std::function<void(std::size_t)>& f) {
+    task_ = &f;
+    errors_.assign(n, std::exception_ptr());
+    remaining_ = n;
+    for (std::size_t i = 0; i < n; ++i) {
+      Queue& queue = queues_[i % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(i);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++generation_;
+    }
+    start_.notify_all();
+    work(0);
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait(lock, [this] { return remaining_ == 0; });
+    }
+    for (const std::exception_ptr& error : errors_)
+      if (error) std::rethrow_exception(error);
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+  };
+
+  void loop(std::size_t self) {
+    std::size_t generation = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_.wait(lock,
+                    [&] { return stop_ || generation_ != generation; });
+        if (stop_) return;
+        generation = generation_;
+      }
+      work(self);
+    }
+  }
+
+  /// Run tasks until all the queues are empty.
+  void work(std::size_t self) {
+    std::size_t task;
+    while (pop(self, task)) {
+      try {
+        (*task_)(task);
+      } catch (const bp::error_already_set&) {
+        // The error indicator of this thread is lost once it is left.
+        ScopedGILEnsure gil;
+        errors_[task] = std::make_exception_ptr(PythonError());
+      } catch (...) {
+        errors_[task] = std::current_exception();
+      }
+      if (--remaining_ == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.notify_all();
+      }
+    }
+  }
+
+  bool pop(std::size_t self, std::size_t& task) {
+    {
+      Queue& own = queues_[self];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = own.tasks.back();
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+      Queue& other = queues_[(self + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(other.mutex);
+      if (!other.tasks.empty()) {
+        task = other.tasks.front();
+        other.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Queue> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  std::size_t generation_;
+  bool stop_;
+  std::atomic<std::size_t> remaining_;
+  const std::function<void(std::size_t)>* task_;
+  std::vector<std::exception_ptr> errors_;
+};
+
+/// Pool of nThreads threads, kept between calls.
+TaskPool& taskPool(std::size_t nThreads) {
+  static std::unique_ptr<TaskPool> pool;
+  if (!pool || pool->size() != nThreads) pool.reset(new TaskPool(nThreads));
+  return *pool;
+}
+
+/// Numpy array of int64 holding a copy of values.
+bp::object intArray(const std::vector<std::int64_t>& values) {
+  static bp::object* empty = new bp::object(bp::import("numpy").attr("empty"));
+  bp::object array = (*empty)(values.size(), "int64");
+  Py_buffer view;
+  if (PyObject_GetBuffer(array.ptr(), &view, PyBUF_C_CONTIGUOUS) != 0)
+    bp::throw_error_already_set();
+  if (!values.empty())
+    std::memcpy(view.buf, values.data(), values.size() * sizeof(values[0]));
+  PyBuffer_Release(&view);
+  return array;
+}
+
+std::vector<SignalBase<int>*> toSignals(bp::object signals) {
+  std::vector<SignalBase<int>*> result;
+  bp::object seq(bp::handle<>(
+      PySequence_Fast(signals.ptr(), "expected a sequence of signals")));
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq.ptr()); ++i)
+    result.push_back(pool::toSignal(PySequence_Fast_GET_ITEM(seq.ptr(), i)));
+  return result;
+}
+
+/// Body of run, calling setInputs (t) if any before recomputing the
+/// outputs at time t.
+bp::list runSteps(bp::object outputs, int t0, int nSteps, bp::object record,
+                  bp::object out, int threads,
+                  const std::function<void(int)>& setInputs) {
+  if (nSteps < 0) throw std::invalid_argument("n_steps must be non-negative");
+  std::vector<SignalBase<int>*> signals = toSignals(outputs);
+  std::vector<std::unique_ptr<Recorder> > recorders;
+  for (SignalBase<int>* signal : toSignals(record))
+    recorders.push_back(makeRecorder(signal));
+  if (!out.is_none() && bp::len(out) != bp::len(record))
+    throw std::invalid_argument("expected one array per recorded signal");
+
+  bp::list arrays;
+  if (nSteps == 0) return arrays;
+
+  // The arrays given are checked before the graph is recomputed, except for
+  // the number of columns of vectors, only known from their first value.
+  std::vector<std::unique_ptr<OutBuffer> > buffers;
+  if (!out.is_none())
+    for (std::size_t i = 0; i < recorders.size(); ++i)
+      buffers.emplace_back(new OutBuffer(bp::object(out[i]).ptr(), nSteps,
+                                         recorders[i]->vector()));
+
+  // The cones with a signal computed by Python are recomputed by the calling
+  // thread, since the callable may call the bindings, which wait for the
+  // graph locked by this thread.
+  std::vector<std::vector<std::size_t> > groups;
+  std::vector<std::size_t> callerOutputs;
+  if (threads > 1) {
+    std::vector<bool> python;
+    std::vector<std::vector<std::size_t> > cones =
+        disjointCones(signals, &python);
+    for (std::size_t g = 0; g < cones.size(); ++g) {
+      if (python[g])
+        callerOutputs.insert(callerOutputs.end(), cones[g].begin(),
+                             cones[g].end());
+      else
+        groups.push_back(cones[g]);
+    }
+    std::sort(callerOutputs.begin(), callerOutputs.end());
+  }
+  // Recompute the outputs at time t, each group of cones by a task.
+  int time = t0;
+  std::function<void(std::size_t)> recomputeGroup = [&](std::size_t g) {
+    for (std::size_t i : groups[g]) signals[i]->recompute(time);
+  };
+  auto step = [&](int t) {
+    if (setInputs) setInputs(t);
+    if (groups.size() > 1) {
+      time = t;
+      for (std::size_t i : callerOutputs) signals[i]->recompute(t);
+      taskPool(std::min(std::size_t(threads), groups.size()))
+          .run(groups.size(), recomputeGroup);
+    } else {
+      for (SignalBase<int>* signal : signals) signal->recompute(t);
+    }
+    inputLog::advance(t);
+  };
+
+  // The first step gives the sizes of the recorded values, so that the
+  // arrays are allocated once before the loop.
+  std::vector<Py_ssize_t> columns(recorders.size());
+  {
+    ScopedGraphCall graphCall;
+    step(t0);
+    for (std::size_t i = 0; i < recorders.size(); ++i)
+      columns[i] = recorders[i]->columns(t0);
+  }
+  std::vector<double*> data(recorders.size());
+  std::vector<Py_ssize_t> stride(recorders.size());
+  for (std::size_t i = 0; i < recorders.size(); ++i) {
+    stride[i] = std::max(columns[i], Py_ssize_t(1));
+    if (out.is_none()) {
+      arrays.append(convert::newArray(nSteps, columns[i], &data[i]));
+    } else {
+      if (recorders[i]->vector()) buffers[i]->checkColumns(columns[i]);
+      data[i] = buffers[i]->data();
+      arrays.append(out[i]);
+    }
+  }
+
+  {
+    ScopedGraphCall graphCall;
+    for (int k = 0; k < nSteps; ++k) {
+      const int t = t0 + k;
+      if (k > 0) {
+        // Lets the short accesses of other threads, such as reading a
+        // value, run between two steps.
+        yieldGraph();
+        step(t);
+      }
+      for (std::size_t i = 0; i < recorders.size(); ++i)
+        recorders[i]->read(t, data[i] + k * stride[i]);
+    }
+  }
+  return arrays;
+}
+
+}  // namespace
+
+/**
+   \brief Recompute output signals at n consecutive times
+   \param outputs signals recomputed at each time, as objects or paths
+   \param t0 first time
+   \param nSteps number of times
+   \param record signals whose values are recorded after each time
+   \param out None, or one array per recorded signal to write the values to
+   \param threads number of threads recomputing the disjoint cones of the
+          outputs in parallel. With 0 or 1, the outputs are recomputed in
+          order by the calling thread.
+   \return one array per recorded signal, of shape (nSteps,) for scalars and
+           (nSteps, size) for vectors
+*/
+bp::list run(bp::object outputs, int t0, int nSteps, bp::object record,
+             bp::object out, int threads) {
+  return runSteps(outputs, t0, nSteps, record, out, threads,
+                  std::function<void(int)>());
+}
+
+/**
+   \brief Replay a log written by inputLog, and recompute output signals at n
+          consecutive times as run does
+   Before recomputing the outputs at time t, the values of the log of time
+   t or before are set.
+*/
+bp::list replay(const std::string& filename, bp::object outputs, int t0,
+                int nSteps, bp::object record, bp::object out, int threads) {
+  valueFile::MappedFile file(filename);
+  std::vector<inputLog::Input> inputs = inputLog::read(file);
+  std::size_t next = 0;
+  auto setInputs = [&](int t) {
+    for (; next < inputs.size() && inputs[next].time <= t; ++next)
+      inputs[next].set(pool::resolveSignal(inputs[next].path));
+  };
+  return runSteps(outputs, t0, nSteps, record, out, threads, setInputs);
+}
+
+bp::list cones(bp::object outputs) {
+  std::vector<std::vector<std::size_t> > groups =
+      disjointCones(toSignals(outputs));
+  bp::list result;
+  for (const std::vector<std::size_t>& group : groups)
+    result.append(to_py_list(group.begin(), group.end()));
+  return result;
+}
+
+/**
+   \brief Dependency graph of the signals of the pool
+   \return a dict of the lists "entity", "signal" and "type" and of the
+           array "time", describing the nodes, and of the arrays "indptr" and
+           "indices", such that node i depends on the nodes
+           indices[indptr[i]:indptr[i + 1]].
+*/
+bp::dict dependencyGraph() {
+  std::vector<const SignalBase<int>*> nodes;
+  std::vector<std::string> entities;
+  std::vector<std::string> signals;
+  std::vector<std::int64_t> indptr(1, 0);
+  std::vector<std::int64_t> indices;
+  std::vector<std::int64_t> times;
+  {
+    ScopedGraphCall graphCall;
+    std::unordered_map<const SignalBase<int>*, std::size_t> index;
+    auto addNode = [&](const SignalBase<int>* signal, const std::string& entity,
+                       const std::string& name) {
+      auto inserted = index.insert(std::make_pair(signal, nodes.size()));
+      if (inserted.second) {
+        nodes.push_back(signal);
+        entities.push_back(entity);
+        signals.push_back(name);
+      }
+      return inserted.first->second;
+    };
+    for (const auto& entity : *pool::snapshot()) {
+      Entity::SignalMap map = entity.second->getSignalMap();
+      for (const auto& signal : map)
+        addNode(signal.second, entity.first, signal.first);
+    }
+    // Signals reached through the dependencies but not registered in an
+    // entity are added to the nodes while walking them.
+    std::vector<const SignalBase<int>*> deps;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      deps.clear();
+      dependencies(nodes[i], deps);
+      for (const SignalBase<int>* dep : deps)
+        indices.push_back(std::int64_t(
+            addNode(dep, entityName(dep), shortName(dep))));
+      indptr.push_back(std::int64_t(indices.size()));
+      times.push_back(nodes[i]->getTime());
+    }
+  }
+
+  bp::list types;
+  for (const SignalBase<int>* node : nodes) types.append(typeName(node));
+  bp::dict graph;
+  graph["entity"] = to_py_list(entities.begin(), entities.end());
+  graph["signal"] = to_py_list(signals.begin(), signals.end());
+  graph["type"] = types;
+  graph["time"] = intArray(times);
+  graph["indptr"] = intArray(indptr);
+  graph["indices"] = intArray(indices);
+  return graph;
+}
+
+}  // namespace graph
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,155 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "dynamic-graph/python/input-log.hh"
+
+#include <dynamic-graph/entity.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "dynamic-graph/python/signal-handle.hh"
+
+namespace dynamicgraph {
+namespace python {
+namespace inputLog {
+
+namespace {
+
+const char magic[8] = {'D', 'G', 'I', 'N', 'P', 'U', 'T', '1'};
+
+class Log {
+ public:
+  Log() : active_(false), time_(0), count_(0) {}
+
+  void start(const std::string& filename, int time) {
+    std::unique_ptr<valueFile::Writer> writer(new valueFile::Writer(filename));
+    writer->write(magic, sizeof(magic));
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_.swap(writer);
+    time_ = time;
+    count_ = 0;
+    active_ = true;
+  }
+
+  std::size_t stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_ = false;
+    if (!writer_) return 0;
+    writer_->file().flush();
+    const bool failed = !writer_->file();
+    writer_.reset();
+    if (failed) throw std::runtime_error("cannot write the input log");
+    return count_;
+  }
+
+  void record(SignalBase<int>& signal) {
+    if (!active_.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!writer_) return;
+    const std::string* path = find(&signal);
+    if (path == NULL) return;
+    writer_->write(std::uint64_t(std::int64_t(time_)));
+    writer_->write(*path);
+    valueFile::writeValue(*writer_, &signal);
+    ++count_;
+  }
+
+  void advance(int t) {
+    if (!active_.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    time_ = t + 1;
+  }
+
+ private:
+  /// Path "entity.signal" of a signal, with the entity and the name to check
+  /// that the signal is still registered.
+  struct Path {
+    Entity* entity;
+    std::string signalName;
+    std::string path;
+  };
+
+  static bool registered(const Path& path, const SignalBase<int>* signal) {
+    const auto& signals = path.entity->getSignalMap();
+    auto it = signals.find(path.signalName);
+    return it != signals.end() && it->second == signal;
+  }
+
+  /// Path of a signal, from the paths of the signals of the pool, built
+  /// again when the pool changed, or when the signal found is no longer
+  /// registered under its path, as a signal deregistered from C++ can leave
+  /// its address to another one.
+  const std::string* find(const SignalBase<int>* signal) {
+    std::shared_ptr<const pool::EntityList> entities = pool::snapshot();
+    if (entities == entities_) {
+      auto it = paths_.find(signal);
+      if (it == paths_.end() || registered(it->second, signal))
+        return it == paths_.end() ? NULL : &it->second.path;
+    }
+    paths_.clear();
+    for (const auto& entity : *entities)
+      for (const auto& s : entity.second->getSignalMap())
+        paths_[s.second] = {entity.second, s.first,
+                            entity.first + "." + s.first};
+    entities_ = entities;
+    auto it = paths_.find(signal);
+    return it == paths_.end() ? NULL : &it->second.path;
+  }
+
+  std::mutex mutex_;
+  std::atomic<bool> active_;
+  std::unique_ptr<valueFile::Writer> writer_;
+  int time_;
+  std::size_t count_;
+  std::unordered_map<const SignalBase<int>*, Path> paths_;
+  std::shared_ptr<const pool::EntityList> entities_;
+};
+
+Log& log() {
+  static Log instance;
+  return instance;
+}
+
+}  // namespace
+
+void start(const std::string& filename, int time) {
+  log().start(filename, time);
+}
+
+std::size_t stop() { return log().stop(); }
+
+void record(SignalBase<int>& signal) { log().record(signal); }
+
+void advance(int t) { log().advance(t); }
+
+std::vector<Input> read(valueFile::MappedFile& file) {
+  if (file.atEnd() ||
+      std::memcmp(file.read(sizeof(magic)), magic, sizeof(magic)) != 0)
+    throw std::runtime_error("not an input log");
+  std::vector<Input> inputs;
+  while (!file.atEnd()) {
+    Input input;
+    input.time = int(std::int64_t(file.readSize()));
+    input.path = file.readString();
+    input.set = valueFile::readValue(file);
+    inputs.push_back(std::move(input));
+  }
+  std::stable_sort(
+      inputs.begin(), inputs.end(),
+      [](const Input& a, const Input& b) { return a.time < b.time; });
+  return inputs;
+}
+
+}  // namespace inputLog
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,55 @@
+# Copyright (C) 2026 CNRS
+"""
+Forward the messages of the real time logger to the logging module.
+
+The messages go to the logger "<prefix>", at the level given to enable:
+the real time logger hands its output streams the text of the messages
+only, without their type (MsgType) or the entity which logged them. They
+are handed to Python by batches, from a thread, so that the GIL is acquired
+once per batch.
+"""
+
+import atexit
+import logging
+
+from . import wrap
+from .entity import VerbosityLevel
+
+# Lowest logging level of the messages accepted by each verbosity level, to
+# choose the level given to enable from the verbosity of the entities.
+VERBOSITY_LEVELS = {
+    VerbosityLevel.VERBOSITY_ALL: logging.DEBUG,
+    VerbosityLevel.VERBOSITY_INFO_WARNING_ERROR: logging.INFO,
+    VerbosityLevel.VERBOSITY_WARNING_ERROR: logging.WARNING,
+    VerbosityLevel.VERBOSITY_ERROR: logging.ERROR,
+    VerbosityLevel.VERBOSITY_NONE: logging.CRITICAL + 1,
+}
+
+
+def _emitter(prefix, level):
+    logger = logging.getLogger(prefix)
+
+    def emit(messages):
+        for message in messages:
+            logger.log(level, message.rstrip("\n"))
+
+    return emit
+
+
+def enable(prefix="dynamic_graph", batch_size=256, period=0.01, level=logging.INFO):
+    """
+    Forward the messages of the real time logger to the logger prefix, at
+    level, by batches of at most batch_size messages, every period seconds.
+    """
+    wrap.addLoggerPythonOutputStream(_emitter(prefix, level), batch_size, period)
+
+
+def disable():
+    """
+    Forward the messages left, and stop forwarding.
+    """
+    wrap.closeLoggerPythonOutputStream()
+
+
+# The thread handing the messages must stop before the interpreter.
+atexit.register(disable)
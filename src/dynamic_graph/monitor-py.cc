@@ -0,0 +1,319 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include <dynamic-graph/linear-algebra.h>
+#include <dynamic-graph/signal-base.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dynamic-graph/python/convert-dg-to-py.hh"
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/recorder.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+
+namespace dynamicgraph {
+namespace python {
+namespace monitor {
+
+namespace {
+
+/// Reference to a Python callable, released with the GIL held.
+typedef std::shared_ptr<PyObject> Callback;
+
+Callback newCallback(PyObject* o) {
+  Py_INCREF(o);
+  return Callback(o, [](PyObject* p) {
+    // Without the interpreter, the callable is leaked.
+    if (Py_IsInitialized()) Py_DECREF(p);
+  });
+}
+
+/// Signal whose value is compared to the last value notified.
+struct Watch {
+  Watch() : handle(NULL), signal(NULL), tolerance(0), notified(false) {}
+
+  /// Path of the signal, looked up at each poll, so that a signal removed
+  /// from the pool is never read.
+  pool::SignalHandle* handle;
+  /// Signal read by recorder, when it is in the pool.
+  SignalBase<int>* signal;
+  std::unique_ptr<Recorder> recorder;
+  double tolerance;
+  Vector last;
+  bool notified;
+  Callback callback;
+};
+
+/// Last change of a signal not delivered yet.
+struct Change {
+  Callback callback;
+  Vector value;
+  bool scalar;
+};
+
+/// Two threads: one compares the values of the watched signals at each
+/// period, without the GIL, and queues the changes. The other delivers the
+/// queued changes to the callbacks, with one acquisition of the GIL per
+/// batch. A change queued while the previous one of the same signal is not
+/// delivered replaces it.
+class Monitor {
+ public:
+  Monitor()
+      : nextId_(1),
+        running_(false),
+        period_(0.02),
+        polls_(0),
+        changes_(0),
+        coalesced_(0),
+        batches_(0) {}
+
+  std::size_t watch(std::unique_ptr<Watch> watch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t id = nextId_++;
+    watches_[id] = std::move(watch);
+    return id;
+  }
+
+  /// \return the callback of the watch, to be released with the GIL held.
+  std::vector<Callback> unwatch(std::size_t id) {
+    std::vector<Callback> released;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::size_t, std::unique_ptr<Watch> >::iterator it =
+        watches_.find(id);
+    if (it == watches_.end())
+      throw std::invalid_argument("no signal is watched with this id");
+    released.push_back(it->second->callback);
+    it->second->callback.reset();
+    watches_.erase(it);
+    std::map<std::size_t, Change>::iterator change = pending_.find(id);
+    if (change != pending_.end()) {
+      released.push_back(change->second.callback);
+      pending_.erase(change);
+    }
+    return released;
+  }
+
+  void start(double period) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) throw std::runtime_error("the monitor is already running");
+    period_ = period;
+    running_ = true;
+    poller_ = std::thread(&Monitor::pollLoop, this);
+    deliverer_ = std::thread(&Monitor::deliverLoop, this);
+  }
+
+  /// \return the changes not delivered, to be released with the GIL held.
+  std::map<std::size_t, Change> stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) return std::map<std::size_t, Change>();
+      running_ = false;
+    }
+    pollWake_.notify_all();
+    deliverWake_.notify_all();
+    poller_.join();
+    deliverer_.join();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::size_t, Change> pending;
+    pending.swap(pending_);
+    return pending;
+  }
+
+  bp::dict stats() {
+    bool running;
+    std::size_t counts[6];
+    {
+      // The polling thread holds the lock while it waits for the graph.
+      ScopedGILRelease nogil;
+      std::lock_guard<std::mutex> lock(mutex_);
+      running = running_;
+      counts[0] = watches_.size();
+      counts[1] = pending_.size();
+      counts[2] = polls_;
+      counts[3] = changes_;
+      counts[4] = coalesced_;
+      counts[5] = batches_;
+    }
+    bp::dict stats;
+    stats["running"] = running;
+    stats["watched"] = counts[0];
+    stats["pending"] = counts[1];
+    stats["polls"] = counts[2];
+    stats["changes"] = counts[3];
+    stats["coalesced"] = counts[4];
+    stats["batches"] = counts[5];
+    return stats;
+  }
+
+ private:
+  void pollLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+      pollWake_.wait_for(lock, std::chrono::duration<double>(period_));
+      if (!running_) break;
+      bool changed = false;
+      {
+        // Never taken with the GIL, see gil.hh.
+        std::lock_guard<std::recursive_mutex> graphLock(graphMutex());
+        for (auto& watch : watches_)
+          changed |= poll(watch.first, *watch.second);
+      }
+      ++polls_;
+      if (changed) deliverWake_.notify_one();
+    }
+  }
+
+  /// Queue a change of the value of a signal.
+  bool poll(std::size_t id, Watch& watch) {
+    if (!watch.handle->valid()) {
+      // A signal registered again may have the address of the removed one.
+      watch.signal = NULL;
+      watch.recorder.reset();
+      return false;
+    }
+    SignalBase<int>* signal = &watch.handle->signal();
+    if (signal != watch.signal) {
+      watch.signal = signal;
+      watch.recorder.reset();
+      watch.notified = false;
+    }
+    try {
+      if (!watch.recorder) watch.recorder = makeRecorder(watch.signal);
+      const Eigen::Index cols = watch.recorder->cachedColumns();
+      value_.resize(std::max(cols, Eigen::Index(1)));
+      watch.recorder->readCached(value_.data());
+      if (watch.notified && watch.last.size() == value_.size() &&
+          !((value_ - watch.last).cwiseAbs().array() > watch.tolerance).any())
+        return false;
+      watch.last = value_;
+      watch.notified = true;
+      Change& change = pending_[id];
+      if (change.callback) ++coalesced_;
+      change.callback = watch.callback;
+      change.value = value_;
+      change.scalar = cols == 0;
+      ++changes_;
+      return true;
+    } catch (const std::exception&) {
+      // Signal of a type that cannot be read, or not computed yet.
+      return false;
+    }
+  }
+
+  void deliverLoop() {
+    std::map<std::size_t, Change> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+      deliverWake_.wait(lock,
+                        [this] { return !running_ || !pending_.empty(); });
+      if (pending_.empty()) continue;
+      batch.swap(pending_);
+      ++batches_;
+      lock.unlock();
+      deliver(batch);
+      lock.lock();
+    }
+  }
+
+  void deliver(std::map<std::size_t, Change>& batch) {
+    if (!Py_IsInitialized()) return;
+    ScopedGILEnsure gil;
+    for (auto& change : batch) {
+      try {
+        bp::object value;
+        if (change.second.scalar) {
+          value = bp::object(change.second.value[0]);
+        } else {
+          double* data;
+          value = convert::newArray(change.second.value.size(), 0, &data);
+          Eigen::Map<Vector>(data, change.second.value.size()) =
+              change.second.value;
+        }
+        bp::call<void>(change.second.callback.get(), value);
+      } catch (const bp::error_already_set&) {
+        PyErr_Print();
+      }
+    }
+    batch.clear();
+  }
+
+  std::mutex mutex_;
+  std::condition_variable pollWake_, deliverWake_;
+  std::map<std::size_t, std::unique_ptr<Watch> > watches_;
+  std::map<std::size_t, Change> pending_;
+  std::size_t nextId_;
+  bool running_;
+  double period_;
+  std::thread poller_, deliverer_;
+  /// Used by the polling thread only.
+  Vector value_;
+  std::size_t polls_, changes_, coalesced_, batches_;
+};
+
+Monitor& monitor() {
+  // Never deleted: the threads are stopped by an atexit handler.
+  static Monitor* instance = new Monitor;
+  return *instance;
+}
+
+}  // namespace
+
+std::size_t watch(bp::object signal, bp::object callback, double tolerance) {
+  if (!(tolerance >= 0))
+    throw std::invalid_argument("the tolerance must be positive");
+  if (!PyCallable_Check(callback.ptr()))
+    throw std::invalid_argument("the callback must be callable");
+  std::unique_ptr<Watch> watch(new Watch);
+  bp::extract<std::string> path(signal);
+  watch->handle = &pool::signalHandle(
+      path.check() ? path() : pool::signalPath(*pool::toSignal(signal.ptr())));
+  watch->signal = &watch->handle->signal();
+  watch->recorder = makeRecorder(watch->signal);
+  watch->tolerance = tolerance;
+  watch->callback = newCallback(callback.ptr());
+  ScopedGILRelease nogil;
+  return monitor().watch(std::move(watch));
+}
+
+void unwatch(std::size_t id) {
+  std::vector<Callback> released;
+  ScopedGILRelease nogil;
+  released = monitor().unwatch(id);
+  // The GIL is acquired again before released is destroyed.
+}
+
+void start(double period) {
+  if (!(period > 0)) throw std::invalid_argument("the period must be > 0");
+  static bool registered = false;
+  if (!registered) {
+    bp::import("atexit").attr("register")(bp::make_function(&stop));
+    registered = true;
+  }
+  ScopedGILRelease nogil;
+  monitor().start(period);
+}
+
+void stop() {
+  std::map<std::size_t, Change> pending;
+  ScopedGILRelease nogil;
+  pending = monitor().stop();
+}
+
+bp::dict stats() { return monitor().stats(); }
+
+}  // namespace monitor
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,189 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include <dynamic-graph/entity.h>
+#include <dynamic-graph/pool.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+
+namespace dynamicgraph {
+namespace python {
+namespace pool {
+
+namespace {
+std::atomic<std::size_t> version_(0);
+
+/// Regular expression equivalent to a glob pattern.
+std::string globToRegex(const std::string& glob) {
+  std::string regex;
+  for (std::size_t i = 0, end; i < glob.size(); ++i) {
+    const char c = glob[i];
+    if (c == '*') {
+      regex += ".*";
+    } else if (c == '?') {
+      regex += '.';
+    } else if (c == '[' &&
+               (end = glob.find(']', i + (glob.compare(i, 2, "[!") ? 2 : 3))) !=
+                   std::string::npos) {
+      // As for fnmatch, a ']' just after '[' or '[!' belongs to the set.
+      std::string set = glob.substr(i + 1, end - i - 1);
+      if (set[0] == '!') set[0] = '^';
+      const std::size_t first = set[0] == '^' ? 1 : 0;
+      if (first < set.size() && set[first] == ']') set.insert(first, "\\");
+      regex += '[' + set + ']';
+      i = end;
+    } else {
+      if (std::string("\\^$.|+()[]{}").find(c) != std::string::npos)
+        regex += '\\';
+      regex += c;
+    }
+  }
+  return regex;
+}
+
+std::regex compile(const std::string& pattern, bool regex) {
+  try {
+    return std::regex(regex ? pattern : globToRegex(pattern));
+  } catch (const std::regex_error& e) {
+    throw std::invalid_argument("invalid pattern \"" + pattern +
+                                "\": " + e.what());
+  }
+}
+}  // namespace
+
+std::size_t version() { return version_.load(); }
+
+void invalidate() { ++version_; }
+
+std::shared_timed_mutex& poolMutex() {
+  static std::shared_timed_mutex mutex;
+  return mutex;
+}
+
+std::shared_ptr<const EntityList> snapshot() {
+  static std::mutex mutex;
+  static std::shared_ptr<const EntityList> entities;
+  static std::size_t entitiesVersion = 0;
+  std::shared_lock<std::shared_timed_mutex> read(poolMutex());
+  const PoolStorage::Entities& map = PoolStorage::getInstance()->getEntityMap();
+  std::lock_guard<std::mutex> lock(mutex);
+  // The version is incremented with the pool locked exclusive.
+  const std::size_t current = version();
+  if (!entities || entitiesVersion != current) {
+    entitiesVersion = current;
+    entities = std::make_shared<const EntityList>(map.begin(), map.end());
+  }
+  return entities;
+}
+
+SignalHandle::SignalHandle(const std::string& path)
+    : path_(path), signal_(NULL), entity_(NULL), version_(std::size_t(-1)) {
+  std::string::size_type dot = path.find('.');
+  if (dot == std::string::npos)
+    throw std::invalid_argument("\"" + path +
+                                "\" is not a path \"entity.signal\"");
+  entityName_ = path.substr(0, dot);
+  signalName_ = path.substr(dot + 1);
+}
+
+SignalBase<int>* SignalHandle::find(const Entity** entity) const {
+  const std::size_t current = version();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (version_ == current) {
+      if (entity != NULL) *entity = entity_;
+      return signal_;
+    }
+  }
+  SignalBase<int>* signal = NULL;
+  const Entity* owner = NULL;
+  {
+    std::shared_lock<std::shared_timed_mutex> read(poolMutex());
+    const PoolStorage::Entities& map =
+        PoolStorage::getInstance()->getEntityMap();
+    PoolStorage::Entities::const_iterator it = map.find(entityName_);
+    if (it != map.end() && it->second->hasSignal(signalName_)) {
+      signal = &it->second->getSignal(signalName_);
+      owner = it->second;
+    }
+  }
+  // The version is read before the lookup: if the pool changed meanwhile,
+  // the version kept is already outdated and the signal is looked up again.
+  std::lock_guard<std::mutex> lock(mutex_);
+  signal_ = signal;
+  entity_ = owner;
+  version_ = current;
+  if (entity != NULL) *entity = owner;
+  return signal;
+}
+
+SignalBase<int>& SignalHandle::signal() const {
+  SignalBase<int>* signal = find();
+  if (signal != NULL) return *signal;
+  // Raises the error of the pool or of the entity.
+  std::shared_lock<std::shared_timed_mutex> read(poolMutex());
+  return PoolStorage::getInstance()->getEntity(entityName_).getSignal(
+      signalName_);
+}
+
+bool SignalHandle::valid() const { return find() != NULL; }
+
+SignalBase<int>* SignalHandle::signalOf(const Entity& entity) const {
+  const Entity* owner;
+  SignalBase<int>* signal = find(&owner);
+  return owner == &entity ? signal : NULL;
+}
+
+std::string signalPath(const SignalBase<int>& signal) {
+  for (const auto& entity : *snapshot())
+    for (const auto& s : entity.second->getSignalMap())
+      if (s.second == &signal) return entity.first + "." + s.first;
+  throw std::invalid_argument("signal " + signal.getName() +
+                              " is not registered in an entity of the pool");
+}
+
+std::vector<std::string> matchSignals(const std::string& entityPattern,
+                                      const std::string& signalPattern,
+                                      bool regex) {
+  const std::regex entityRegex = compile(entityPattern, regex);
+  const std::regex signalRegex = compile(signalPattern, regex);
+  std::vector<std::string> paths;
+  for (const auto& entity : *snapshot()) {
+    if (!std::regex_match(entity.first, entityRegex)) continue;
+    for (const auto& signal : entity.second->getSignalMap())
+      if (std::regex_match(signal.first, signalRegex))
+        paths.push_back(entity.first + "." + signal.first);
+  }
+  return paths;
+}
+
+SignalHandle& signalHandle(const std::string& path) {
+  static std::shared_timed_mutex mutex;
+  static std::unordered_map<std::string, std::unique_ptr<SignalHandle> >
+      handles;
+  {
+    std::shared_lock<std::shared_timed_mutex> read(mutex);
+    auto it = handles.find(path);
+    if (it != handles.end()) return *it->second;
+  }
+  std::unique_ptr<SignalHandle> handle(new SignalHandle(path));
+  std::unique_lock<std::shared_timed_mutex> write(mutex);
+  std::unique_ptr<SignalHandle>& interned = handles[path];
+  if (!interned) interned = std::move(handle);
+  return *interned;
+}
+
+}  // namespace pool
+}  // namespace python
+}  // namespace dynamicgraph
@@ -3,9 +3,14 @@
 #include <dynamic-graph/entity.h>
 #include <dynamic-graph/pool.h>
 
+#include <memory>
+#include <shared_mutex>
+#include <string>
 #include <vector>
 
 #include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/signal-handle.hh"
 
 namespace dynamicgraph {
 namespace python {
@@ -20,17 +25,154 @@ const std::map<std::string, Entity*>* getEntityMap() {
   return &PoolStorage::getInstance()->getEntityMap();
 }
 
+namespace {
+
+/// Python tuples of the names, of the entities and of the pairs (name,
+/// entity) of the pool.
+struct EntityViews {
+  std::shared_ptr<const EntityList> entities;
+  bp::tuple names;
+  bp::tuple values;
+  bp::tuple items;
+};
+
+/// Return the views of the pool, rebuilt when pool::snapshot returns another
+/// list, i.e. if the entities of the pool changed since the last call, even
+/// from C++.
+const EntityViews& entityViews() {
+  // Never deleted, as the tuples cannot outlive the interpreter.
+  static EntityViews* views = NULL;
+  std::shared_ptr<const EntityList> entities = snapshot();
+  if (views != NULL && views->entities == entities) return *views;
+
+  bp::list names, values, items;
+  for (const auto& el : *entities) {
+    names.append(el.first);
+    values.append(bp::ptr(el.second));
+    items.append(bp::make_tuple(el.first, bp::ptr(el.second)));
+  }
+  if (views == NULL) views = new EntityViews;
+  views->entities = entities;
+  views->names = bp::tuple(names);
+  views->values = bp::tuple(values);
+  views->items = bp::tuple(items);
+  return *views;
+}
+
+}  // namespace
+
+bp::tuple entityNames() { return entityViews().names; }
+
+bp::tuple entities() { return entityViews().values; }
+
+bp::tuple items() { return entityViews().items; }
+
+std::size_t size() {
+  std::shared_lock<std::shared_timed_mutex> read(poolMutex());
+  return PoolStorage::getInstance()->getEntityMap().size();
+}
+
+bool hasEntity(const std::string& name) {
+  std::shared_lock<std::shared_timed_mutex> read(poolMutex());
+  return PoolStorage::getInstance()->getEntityMap().count(name) != 0;
+}
+
+Entity* getEntity(const std::string& name) {
+  std::shared_lock<std::shared_timed_mutex> read(poolMutex());
+  return PoolStorage::getInstance()->getEntityMap().at(name);
+}
+
+void addEntity(const std::string& name, Entity* entity) {
+  {
+    std::unique_lock<std::shared_timed_mutex> write(poolMutex());
+    PoolStorage* pool = PoolStorage::getInstance();
+    if (pool->existEntity(name)) return;
+    pool->registerEntity(name, entity);
+    invalidate();
+  }
+}
+
 /**
    \brief Get list of entities
 */
-bp::list getEntityList() {
-  std::vector<std::string> entityNames;
-  bp::list res;
-  const PoolStorage::Entities& listOfEntities =
-      PoolStorage::getInstance()->getEntityMap();
-
-  for (const auto& el : listOfEntities) res.append(el.second->getName());
-  return res;
+bp::list getEntityList() { return bp::list(entityNames()); }
+
+namespace {
+
+const char* toString(PyObject* o) {
+  const char* s = PyUnicode_Check(o) ? PyUnicode_AsUTF8(o) : NULL;
+  if (s == NULL) {
+    PyErr_Clear();
+    throw std::invalid_argument("expected a string, got " + obj_to_str(o));
+  }
+  return s;
+}
+
+}  // namespace
+
+SignalBase<int>* toSignal(PyObject* o) {
+  if (PyUnicode_Check(o)) return &resolveSignal(toString(o));
+  bp::extract<SignalBase<int>*> signal(o);
+  if (!signal.check())
+    throw std::invalid_argument(
+        "expected a signal or a path \"entity.signal\", got " +
+        obj_to_str(o));
+  return signal();
+}
+
+namespace {
+
+/// Call f on the two elements of each pair of a sequence, and collect the
+/// errors as a list of (index, message).
+template <typename F>
+bp::list forEachPair(bp::object pairs, F f) {
+  bp::object seq(bp::handle<>(
+      PySequence_Fast(pairs.ptr(), "expected a sequence of pairs")));
+  bp::list errors;
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq.ptr()); ++i) {
+    PyObject* pair = PySequence_Fast_GET_ITEM(seq.ptr(), i);
+    try {
+      if ((!PyTuple_Check(pair) && !PyList_Check(pair)) ||
+          PySequence_Fast_GET_SIZE(pair) != 2)
+        throw std::invalid_argument("expected a pair, got " +
+                                    obj_to_str(pair));
+      f(PySequence_Fast_GET_ITEM(pair, 0), PySequence_Fast_GET_ITEM(pair, 1));
+    } catch (const std::exception& e) {
+      errors.append(bp::make_tuple(i, e.what()));
+    }
+  }
+  return errors;
+}
+
+}  // namespace
+
+/**
+   \brief Create entities
+   \param entities sequence of (class name, instance name)
+   \return the list of errors, as (index in entities, message)
+*/
+bp::list createEntities(bp::object entities) {
+  return forEachPair(entities, [](PyObject* className, PyObject* name) {
+    const char* c = toString(className);
+    const char* n = toString(name);
+    ScopedGraphCall graphCall;
+    entity::create(c, n);
+  });
+}
+
+/**
+   \brief Plug output signals into input signals
+   \param plugs sequence of (output signal, input signal), where signals are
+          given either as objects or as paths "entity.signal"
+   \return the list of errors, as (index in plugs, message)
+*/
+bp::list plugMany(bp::object plugs) {
+  return forEachPair(plugs, [](PyObject* signalOut, PyObject* signalIn) {
+    SignalBase<int>* out = toSignal(signalOut);
+    SignalBase<int>* in = toSignal(signalIn);
+    ScopedGraphCall graphCall;
+    in->plug(out);
+  });
 }
 
 }  // namespace pool
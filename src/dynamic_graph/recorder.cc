@@ -0,0 +1,94 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "dynamic-graph/python/recorder.hh"
+
+#include <dynamic-graph/signal.h>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace dynamicgraph {
+namespace python {
+
+namespace {
+
+template <typename T>
+class ScalarRecorder : public Recorder {
+ public:
+  explicit ScalarRecorder(Signal<T, int>* signal) : signal_(signal) {}
+
+  bool vector() const { return false; }
+  Eigen::Index columns(int) { return 0; }
+  void read(int t, double* row) { *row = double(signal_->access(t)); }
+  Eigen::Index cachedColumns() { return 0; }
+  void readCached(double* row) { *row = double(signal_->accessCopy()); }
+
+ private:
+  Signal<T, int>* signal_;
+};
+
+class VectorRecorder : public Recorder {
+ public:
+  explicit VectorRecorder(Signal<Vector, int>* signal)
+      : signal_(signal), size_(0) {}
+
+  bool vector() const { return true; }
+  Eigen::Index columns(int t) {
+    size_ = signal_->access(t).size();
+    return size_;
+  }
+  void read(int t, double* row) { copy(signal_->access(t), t, row); }
+  Eigen::Index cachedColumns() {
+    size_ = signal_->accessCopy().size();
+    return size_;
+  }
+  void readCached(double* row) {
+    copy(signal_->accessCopy(), signal_->getTime(), row);
+  }
+
+ private:
+  void copy(const Vector& value, int t, double* row) {
+    if (value.size() != size_) {
+      std::ostringstream oss;
+      oss << "the size of signal " << signal_->getName() << " changed from "
+          << size_ << " to " << value.size() << " at time " << t;
+      throw std::length_error(oss.str());
+    }
+    Eigen::Map<Vector>(row, size_) = value;
+  }
+
+  Signal<Vector, int>* signal_;
+  Eigen::Index size_;
+};
+
+template <typename T>
+std::unique_ptr<Recorder> scalarRecorder(SignalBase<int>* signal) {
+  Signal<T, int>* s = dynamic_cast<Signal<T, int>*>(signal);
+  return std::unique_ptr<Recorder>(s ? new ScalarRecorder<T>(s) : NULL);
+}
+
+}  // namespace
+
+std::unique_ptr<Recorder> makeRecorder(SignalBase<int>* signal) {
+  std::unique_ptr<Recorder> recorder;
+  if (!(recorder = scalarRecorder<double>(signal)) &&
+      !(recorder = scalarRecorder<float>(signal)) &&
+      !(recorder = scalarRecorder<int>(signal)) &&
+      !(recorder = scalarRecorder<bool>(signal))) {
+    if (Signal<Vector, int>* s = dynamic_cast<Signal<Vector, int>*>(signal))
+      recorder.reset(new VectorRecorder(s));
+    else
+      throw std::invalid_argument(
+          "cannot record signal " + signal->getName() +
+          ": only signals of double, float, int, bool and vector are "
+          "supported");
+  }
+  return recorder;
+}
+
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,78 @@
+# Copyright (C) 2026 CNRS
+"""
+Reader of the binary logs written by wrap.addLoggerBinaryOutputStream.
+
+The records are decoded lazily, one segment mapped in memory at a time, so
+that large logs can be filtered without loading them.
+"""
+
+import collections
+import glob
+import mmap
+import re
+import struct
+
+# The logger gives the text of the messages only: a record is the message
+# and its index in the log, from 0.
+Record = collections.namedtuple("Record", ["index", "message"])
+
+_MAGIC = b"DGRTLOG1"
+_SEGMENT_HEADER = struct.Struct("=8sQQQ")
+_RECORD_HEADER = struct.Struct("=II")
+
+
+def segments(prefix):
+    """
+    Return the file names of the segments of a log, in order.
+    """
+    pattern = re.compile(re.escape(prefix) + r"\.(\d+)\.dglog$")
+    names = []
+    for name in glob.glob(glob.escape(prefix) + ".*.dglog"):
+        match = pattern.match(name)
+        if match:
+            names.append((int(match.group(1)), name))
+    return [name for _, name in sorted(names)]
+
+
+def _read_segment(name, index, contains, since, until):
+    """
+    Iterate over the records of a segment, whose first record has index, and
+    end with the index following its last record.
+    """
+    with open(name, "rb") as f:
+        with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as data:
+            magic, _, _, used = _SEGMENT_HEADER.unpack_from(data, 0)
+            if magic != _MAGIC:
+                raise ValueError("%s is not a segment of a log" % name)
+            offset = _SEGMENT_HEADER.size
+            while offset < used:
+                size, message_size = _RECORD_HEADER.unpack_from(data, offset)
+                if size < _RECORD_HEADER.size:
+                    raise ValueError("%s is corrupted" % name)
+                start = offset + _RECORD_HEADER.size
+                offset += size
+                index += 1
+                if index <= since or (until is not None and index > until):
+                    continue
+                message = data[start : start + message_size]
+                if contains is not None and contains not in message:
+                    continue
+                yield Record(index - 1, message.decode(errors="replace"))
+    return index
+
+
+def read(prefix, contains=None, since=0, until=None):
+    """
+    Iterate over the records of a log.
+
+    - prefix: prefix given to addLoggerBinaryOutputStream,
+    - contains: text the messages of the records to keep contain,
+    - since, until: bounds of the index of the records.
+    """
+    if contains is not None:
+        contains = contains.encode()
+    index = 0
+    for name in segments(prefix):
+        if until is not None and index >= until:
+            return
+        index = yield from _read_segment(name, index, contains, since, until)
@@ -0,0 +1,153 @@
+# Copyright (C) 2026 CNRS
+"""
+Reader of the shared memory segments written by TracerSharedMemory.
+
+The reader only maps the segment: it takes no lock and never waits for the
+process publishing the signals. A record written or overwritten while it is
+copied is detected with the sequence number of its slot. It maps the
+segments from /dev/shm, and is thus only available on Linux.
+"""
+
+import collections
+import mmap
+import os
+import struct
+import sys
+
+import numpy as np
+
+Signal = collections.namedtuple("Signal", ["name", "width", "ndim"])
+
+_MAGIC = b"DGSHMEM1"
+_HEADER = struct.Struct("=8sIIQQQII")
+_DESCRIPTOR = struct.Struct("=III")
+_PUBLISHED = struct.Struct("=Q")
+_PUBLISHED_OFFSET = 32
+_CLOSED = struct.Struct("=I")
+_CLOSED_OFFSET = 40
+
+
+def path(segment):
+    """
+    Return the file of a segment, such as /dev/shm/name for /name.
+
+    Only Linux exposes the segments as files: the reader is not available on
+    the other systems.
+    """
+    if not sys.platform.startswith("linux"):
+        raise NotImplementedError("shared memory segments are read on Linux only")
+    return os.path.join("/dev/shm", segment.lstrip("/"))
+
+
+class Reader:
+    """
+    Map a segment published by TracerSharedMemory.openSegment.
+
+    The records are numpy records of fields "seq", "time" and the names of
+    the signals.
+    """
+
+    def __init__(self, segment):
+        with open(path(segment), "rb") as f:
+            size = os.fstat(f.fileno()).st_size
+            if size < _HEADER.size:
+                raise ValueError("%s is not ready" % segment)
+            self._data = mmap.mmap(f.fileno(), size, access=mmap.ACCESS_READ)
+        magic, header_size, count, capacity, slot_size, _, _, _ = (
+            _HEADER.unpack_from(self._data, 0)
+        )
+        if magic != _MAGIC:
+            self._data.close()
+            raise ValueError("%s is not ready or not a published segment" % segment)
+        self.segment = segment
+        self.capacity = capacity
+        self.signals = []
+        offset = _HEADER.size
+        for _ in range(count):
+            width, ndim, name_size = _DESCRIPTOR.unpack_from(self._data, offset)
+            start = offset + _DESCRIPTOR.size
+            name = self._data[start : start + name_size].decode(errors="replace")
+            self.signals.append(Signal(name, width, ndim))
+            offset += (_DESCRIPTOR.size + name_size + 7) // 8 * 8
+        fields = [("seq", "=u8"), ("time", "=i8")]
+        for signal in self.signals:
+            if signal.ndim == 0:
+                fields.append((signal.name, "=f8"))
+            else:
+                fields.append((signal.name, "=f8", (signal.width,)))
+        self.dtype = np.dtype(fields)
+        if self.dtype.itemsize != slot_size:
+            self._data.close()
+            raise ValueError("%s is corrupted" % segment)
+        self._slots = np.frombuffer(
+            self._data, dtype=self.dtype, count=capacity, offset=header_size
+        )
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def close(self):
+        """
+        Unmap the segment. The records returned before stay valid.
+        """
+        self._slots = None
+        self._data.close()
+
+    @property
+    def published(self):
+        """
+        Number of records published so far.
+        """
+        return _PUBLISHED.unpack_from(self._data, _PUBLISHED_OFFSET)[0]
+
+    @property
+    def closed(self):
+        """
+        Whether the publisher closed the segment. A new segment of the same
+        name needs a new reader.
+        """
+        return _CLOSED.unpack_from(self._data, _CLOSED_OFFSET)[0] != 0
+
+    def read(self, index):
+        """
+        Return a copy of record index, or None if it is not published yet or
+        overwritten.
+        """
+        slot = index % self.capacity
+        expected = 2 * index + 2
+        if self._slots["seq"][slot] != expected:
+            return None
+        record = self._slots[slot : slot + 1].copy()
+        if self._slots["seq"][slot] != expected:
+            return None
+        return record[0]
+
+    def latest(self):
+        """
+        Return a copy of the last record published, or None if there is none.
+        """
+        while True:
+            published = self.published
+            if published == 0:
+                return None
+            record = self.read(published - 1)
+            if record is not None:
+                return record
+
+    def since(self, index):
+        """
+        Return a copy of the records published from index on, as a numpy
+        array, and the index of the next record to read. The records
+        overwritten before they are copied are left out.
+        """
+        end = self.published
+        rows = np.arange(max(index, end - self.capacity, 0), end, dtype=np.uint64)
+        slots = rows % np.uint64(self.capacity)
+        expected = 2 * rows + 2
+        before = self._slots["seq"][slots]
+        records = self._slots[slots]
+        after = self._slots["seq"][slots]
+        return records[(before == expected) & (after == expected)], end
@@ -12,6 +12,8 @@
 #include <sstream>
 
 #include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/input-log.hh"
 #include "dynamic-graph/python/signal-wrapper.hh"
 #include "dynamic-graph/python/signal.hh"
 
@@ -41,11 +43,16 @@ template <typename Time>
 void exposeSignalBase(const char* name) {
   typedef SignalBase<Time> S_t;
   bp::class_<S_t, boost::noncopyable>(name, bp::no_init)
-      .add_property("time",
-                    bp::make_function(
-                        &S_t::getTime,
-                        bp::return_value_policy<bp::copy_const_reference>()),
-                    &S_t::setTime)
+      .add_property(
+          "time",
+          +[](const S_t& s) -> Time {
+            ScopedGraphAccess graphAccess;
+            return s.getTime();
+          },
+          +[](S_t& s, const Time& t) {
+            ScopedGraphAccess graphAccess;
+            s.setTime(t);
+          })
       .add_property("name",
                     bp::make_function(
                         &S_t::getName,
@@ -61,27 +68,63 @@ void exposeSignalBase(const char* name) {
             return ret;
           })
 
-      .def("plug", &S_t::plug, "Plug the signal to another signal")
-      .def("unplug", &S_t::unplug, "Unplug the signal")
-      .def("isPlugged", &S_t::isPlugged, "Whether the signal is plugged")
-      .def("getPlugged", &S_t::getPluged,
-           bp::return_value_policy<bp::reference_existing_object>(),
-           "To which signal the signal is plugged")
+      .def(
+          "plug",
+          +[](S_t& s, S_t* other) {
+            ScopedGraphAccess graphAccess;
+            s.plug(other);
+          },
+          "Plug the signal to another signal")
+      .def(
+          "unplug",
+          +[](S_t& s) {
+            ScopedGraphAccess graphAccess;
+            s.unplug();
+          },
+          "Unplug the signal")
+      .def(
+          "isPlugged",
+          +[](const S_t& s) {
+            ScopedGraphAccess graphAccess;
+            return s.isPlugged();
+          },
+          "Whether the signal is plugged")
+      .def(
+          "getPlugged",
+          +[](const S_t& s) {
+            ScopedGraphAccess graphAccess;
+            return s.getPluged();
+          },
+          bp::return_value_policy<bp::reference_existing_object>(),
+          "To which signal the signal is plugged")
 
-      .def("recompute", &S_t::recompute, "Recompute the signal at given time")
+      .def(
+          "recompute",
+          +[](S_t& s, const time_type& t) {
+            ScopedGraphCall graphCall;
+            s.recompute(t);
+            inputLog::advance(t);
+          },
+          "Recompute the signal at given time")
 
       .def(
           "__str__",
           +[](const S_t& s) -> std::string {
             std::ostringstream oss;
-            s.display(oss);
+            {
+              ScopedGraphAccess graphAccess;
+              s.display(oss);
+            }
             return oss.str();
           })
       .def(
           "displayDependencies",
           +[](const S_t& s, int time) -> std::string {
             std::ostringstream oss;
-            s.displayDependencies(oss, time);
+            {
+              ScopedGraphAccess graphAccess;
+              s.displayDependencies(oss, time);
+            }
             return oss.str();
           },
           "Print the signal dependencies in a string");
@@ -95,12 +138,15 @@ auto exposeSignal<MatrixHomogeneous, time_type>(const std::string& name) {
   obj.add_property(
       "value",
       +[](const S_t& signal) -> Matrix4 {
+        ScopedGraphAccess graphAccess;
         return signal.accessCopy().matrix();
       },
       +[](S_t& signal, const Matrix4& v) {
         // TODO it isn't hard to support pinocchio::SE3 type here.
         // However, this adds a dependency to pinocchio.
+        ScopedGraphAccess graphAccess;
         signal.setConstant(MatrixHomogeneous(v));
+        inputLog::record(signal);
       },
       "the signal value.");
   return obj;
@@ -141,6 +187,7 @@ SignalWrapper<T, int>* createSignalWrapperTpl(const char* name, bp::object o,
 }
 
 PythonSignalContainer* getPythonSignalContainer() {
+  ScopedGraphCall graphCall;
   Entity* obj = entity::create("PythonSignalContainer", "python_signals");
   return dynamic_cast<PythonSignalContainer*>(obj);
 }
@@ -6,15 +6,19 @@
 #include <dynamic-graph/command-bind.h>
 #include <dynamic-graph/factory.h>
 
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+
 namespace dynamicgraph {
 namespace python {
 void PythonSignalContainer::signalRegistration(
     const SignalArray<int>& signals) {
   Entity::signalRegistration(signals);
+  pool::invalidate();
 }
 
 void PythonSignalContainer::rmSignal(const std::string& name) {
   Entity::signalDeregistration(name);
+  pool::invalidate();
 }
 
 DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(PythonSignalContainer,
@@ -35,5 +39,13 @@ template class SignalWrapper<int, int>;
 template class SignalWrapper<float, int>;
 template class SignalWrapper<double, int>;
 template class SignalWrapper<Vector, int>;
+
+bool isSignalWrapper(const SignalBase<int>* signal) {
+  return dynamic_cast<const SignalWrapper<bool, int>*>(signal) != NULL ||
+         dynamic_cast<const SignalWrapper<int, int>*>(signal) != NULL ||
+         dynamic_cast<const SignalWrapper<float, int>*>(signal) != NULL ||
+         dynamic_cast<const SignalWrapper<double, int>*>(signal) != NULL ||
+         dynamic_cast<const SignalWrapper<Vector, int>*>(signal) != NULL;
+}
 }  // namespace python
 }  // namespace dynamicgraph
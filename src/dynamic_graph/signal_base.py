@@ -6,47 +6,36 @@ from __future__ import print_function
 
 # I kept what follows for backward compatibility but I think it should be
 # removed
-import re
-
 from .wrap import SignalBase  # noqa
+from .wrap import array_to_string, string_to_array
 from .wrap import create_signal_wrapper as SignalWrapper  # noqa
 
 
+def _stringToArray(string, ndim):
+    try:
+        array = string_to_array(string)
+    except ValueError as e:
+        raise TypeError(str(e))
+    if array.ndim != ndim:
+        raise TypeError(
+            "%s is not a %s" % (string.strip(), "vector" if ndim == 1 else "matrix")
+        )
+    return array
+
+
 def stringToTuple(vector):
     """
     Transform a string of format '[n](x_1,x_2,...,x_n)' into a tuple of numbers.
     """
-    # Find vector length
-    a = re.match(r"\[(\d+)\]", vector)
-    size = int(a.group(1))
-    # remove '[n]' prefix
-    vector = vector[len(a.group(0)) :]
-    # remove '(' and ')' at beginning and end
-    vector = vector.lstrip("(").rstrip(")\n")
-    # split string by ','
-    vector = vector.split(",")
-    # check size
-    if len(vector) != size:
-        raise TypeError(
-            "displayed size "
-            + str(size)
-            + " of vector does not fit actual size: "
-            + str(len(vector))
-        )
-    res = map(float, vector)
-    return tuple(res)
+    return tuple(_stringToArray(vector, 1).tolist())
 
 
 def tupleToString(vector):
     """
     Transform a tuple of numbers into a string of format
-    '[n](x_1, x_2, ..., x_n)'
+    '[n](x_1,x_2,...,x_n)'. The numbers are written exactly.
     """
-    string = "[%d](" % len(vector)
-    for x in vector[:-1]:
-        string += "%f," % x
-    string += "%f)" % vector[-1]
-    return string
+    return array_to_string(vector)
 
 
 def stringToMatrix(string):
@@ -55,56 +44,18 @@ def stringToMatrix(string):
     '[n,m]((x_11,x_12,...,x_1m),...,(x_n1,x_n2,...,x_nm))' into a tuple
     of tuple of numbers.
     """
-    # Find matrix size
-    a = re.search(r"\[(\d+),(\d+)]", string)
-    nRows = int(a.group(1))
-    nCols = int(a.group(2))
-    # Remove '[n,m]' prefix
-    string = string[len(a.group(0)) :]
-    rows = string.split("),(")
-    if len(rows) != nRows:
-        raise TypeError(
-            "displayed nb rows "
-            + nRows
-            + " of matrix does not fit actual nb rows: "
-            + str(len(rows))
-        )
-    m = []
-    for rstr in rows:
-        rstr = rstr.lstrip("(").rstrip(")\n")
-        r = map(float, rstr.split(","))
-        if len(r) != nCols:
-            raise TypeError(
-                "one row length "
-                + len(r)
-                + " of matrix does not fit displayed nb cols: "
-                + nCols
-            )
-        m.append(tuple(r))
-    return tuple(m)
+    return tuple(tuple(row) for row in _stringToArray(string, 2).tolist())
 
 
 def matrixToString(matrix):
     """
     Transform a tuple of tuple of numbers into a string of format
-    '[n,m]((x_11,x_12,...,x_1m),...,(x_n1,x_n2,...,x_nm))'.
+    '[n,m]((x_11,x_12,...,x_1m),...,(x_n1,x_n2,...,x_nm))'. The numbers are
+    written exactly.
     """
-    nRows = len(matrix)
-    if nRows == 0:
+    if len(matrix) == 0:
         return "[0,0](())"
-    nCols = len(matrix[0])
-    string = "[%d,%d](" % (nRows, nCols)
-    for r in range(nRows):
-        string += "("
-        for c in range(nCols):
-            string += str(float(matrix[r][c]))
-            if c != nCols - 1:
-                string += ","
-        string += ")"
-        if r != nRows - 1:
-            string += ","
-    string += ")"
-    return string
+    return array_to_string(matrix)
 
 
 def objectToString(obj):
@@ -166,3 +117,16 @@ def stringToObject(string):
         return float(string)
     except Exception:
         return string
+
+
+def _at(self, time):
+    """
+    Return an asyncio future done once the signal is computed at time or
+    later: await sig.at(t). See dynamic_graph.aio.
+    """
+    from . import aio
+
+    return aio.at(self, time)
+
+
+SignalBase.at = _at
@@ -0,0 +1,160 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include <dynamic-graph/entity.h>
+#include <dynamic-graph/pool.h>
+#include <dynamic-graph/signal-base.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+#include "dynamic-graph/python/value-file.hh"
+
+namespace dynamicgraph {
+namespace python {
+namespace pool {
+
+namespace {
+
+// Layout of a snapshot, written with valueFile::Writer:
+//
+//   header:   magic "DGSNAP01", uint64 number of entities, of plugs and of
+//             values
+//   entity:   string class name, string name
+//   plug:     string path of the input signal, string path of the output
+//   value:    string path, value
+const char magic[8] = {'D', 'G', 'S', 'N', 'A', 'P', '0', '1'};
+
+using valueFile::MappedFile;
+using valueFile::readValue;
+using valueFile::Setter;
+using valueFile::writeValue;
+using valueFile::Writer;
+
+typedef std::vector<std::pair<std::size_t, std::string> > Errors;
+
+}  // namespace
+
+/**
+   \brief Write the entities, the plugs and the constant values of the
+          signals of the pool to a file
+*/
+void saveState(const std::string& filename) {
+  ScopedGraphCall graphCall;
+  std::shared_ptr<const EntityList> entities = snapshot();
+  std::unordered_map<const SignalBase<int>*, std::string> paths;
+  std::vector<std::pair<std::string, SignalBase<int>*> > signals;
+  for (const auto& entity : *entities) {
+    Entity::SignalMap signalMap = entity.second->getSignalMap();
+    for (const auto& signal : signalMap) {
+      std::string path = entity.first + "." + signal.first;
+      paths[signal.second] = path;
+      signals.push_back(std::make_pair(path, signal.second));
+    }
+  }
+  // A constant input signal is plugged into itself.
+  std::vector<std::pair<std::string, const std::string*> > plugs;
+  std::vector<std::pair<std::string, SignalBase<int>*> > constants;
+  for (const auto& signal : signals) {
+    if (!signal.second->isPlugged()) continue;
+    SignalBase<int>* plugged = signal.second->getPluged();
+    if (plugged == signal.second) {
+      constants.push_back(signal);
+    } else if (plugged != NULL) {
+      auto path = paths.find(plugged);
+      if (path != paths.end())
+        plugs.push_back(std::make_pair(signal.first, &path->second));
+    }
+  }
+
+  Writer writer(filename);
+  writer.write(magic, sizeof(magic));
+  writer.write(std::uint64_t(entities->size()));
+  writer.write(std::uint64_t(plugs.size()));
+  writer.write(std::uint64_t(constants.size()));
+  for (const auto& entity : *entities) {
+    writer.write(entity.second->getClassName());
+    writer.write(entity.first);
+  }
+  for (const auto& plug : plugs) {
+    writer.write(plug.first);
+    writer.write(*plug.second);
+  }
+  for (const auto& constant : constants) {
+    writer.write(constant.first);
+    writeValue(writer, constant.second);
+  }
+  writer.file().flush();
+  if (!writer.file()) throw std::runtime_error("cannot write " + filename);
+}
+
+/**
+   \brief Restore a file written by saveState
+   Missing entities are created, then the constant values are set and the
+   signals plugged.
+   \return the list of errors as (index, message), where index counts the
+           entities, then the values, then the plugs of the file.
+*/
+bp::list loadState(const std::string& filename) {
+  Errors errors;
+  {
+    ScopedGraphCall graphCall;
+    MappedFile file(filename);
+    if (std::memcmp(file.read(sizeof(magic)), magic, sizeof(magic)) != 0)
+      throw std::runtime_error(filename + " is not a snapshot");
+    std::uint64_t nEntities = file.readSize();
+    std::uint64_t nPlugs = file.readSize();
+    std::uint64_t nValues = file.readSize();
+
+    std::size_t index = 0;
+    auto tryOrRecord = [&](const std::function<void()>& f) {
+      try {
+        f();
+      } catch (const std::exception& exc) {
+        errors.push_back(std::make_pair(index, std::string(exc.what())));
+      }
+      ++index;
+    };
+    for (std::uint64_t i = 0; i < nEntities; ++i) {
+      std::string className = file.readString();
+      std::string name = file.readString();
+      tryOrRecord([&] { entity::create(className.c_str(), name.c_str()); });
+    }
+    std::vector<std::pair<std::string, std::string> > plugs;
+    for (std::uint64_t i = 0; i < nPlugs; ++i) {
+      std::string in = file.readString();
+      plugs.push_back(std::make_pair(in, file.readString()));
+    }
+    for (std::uint64_t i = 0; i < nValues; ++i) {
+      std::string path = file.readString();
+      Setter set = readValue(file);
+      tryOrRecord([&] { set(resolveSignal(path)); });
+    }
+    for (const auto& plug : plugs) {
+      tryOrRecord(
+          [&] { resolveSignal(plug.first).plug(&resolveSignal(plug.second)); });
+    }
+  }
+
+  bp::list result;
+  for (const auto& error : errors)
+    result.append(bp::make_tuple(error.first, error.second));
+  return result;
+}
+
+}  // namespace pool
+}  // namespace python
+}  // namespace dynamicgraph
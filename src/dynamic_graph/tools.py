@@ -13,3 +13,15 @@ def addTrace(robot, trace, entityName, signalName, autoRecompute=True):
     trace.add(signal, filename)
     if autoRecompute:
         robot.device.after.addSignal(signal)
+
+
+def addTraces(
+    robot, trace, entityPattern, signalPattern="*", autoRecompute=True, regex=False
+):
+    """
+    Add the signals whose entity and signal names match glob patterns, or
+    regular expressions if regex is True, to a tracer and recompute them
+    automatically if necessary. Return their paths "entity.signal".
+    """
+    after = robot.device.after if autoRecompute else None
+    return trace.addSignals(entityPattern, signalPattern, regex, after)
@@ -0,0 +1,296 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "dynamic-graph/python/trace-file.hh"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+namespace dynamicgraph {
+namespace python {
+namespace trace {
+
+namespace {
+
+/// Stream buffer of dg_debugfile.
+///
+/// Each thread gathers its text in a buffer of its own, without lock, until
+/// it ends a line. The complete lines kept by the filter are then appended
+/// under a mutex to the text that a thread, started at the first trace,
+/// writes to the file and rotates.
+class TraceBuffer : public std::streambuf {
+ public:
+  typedef std::vector<std::string> Tokens;
+
+  TraceBuffer()
+      : enabled_(true),
+        generation_(0),
+        tokens_(std::make_shared<const Tokens>()),
+        filename_("/tmp/dynamic-graph-traces.txt"),
+        maxBytes_(0),
+        maxFiles_(1),
+        stop_(false),
+        requested_(0),
+        flushed_(0),
+        stream_(NULL) {}
+
+  ~TraceBuffer() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    if (stream_ != NULL) stream_->rdbuf(NULL);
+  }
+
+  void install(std::ostream& stream) {
+    stream_ = &stream;
+    stream.rdbuf(this);
+    stream.clear();
+  }
+
+  void enable(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = true;
+    filename_ = filename;
+    ++generation_;
+  }
+
+  void disable() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      enabled_ = false;
+      pending_.clear();
+      ++generation_;
+    }
+    flush();
+  }
+
+  void setRotation(std::size_t maxBytes, std::size_t maxFiles) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxBytes_ = maxBytes;
+    maxFiles_ = maxFiles == 0 ? 1 : maxFiles;
+  }
+
+  void setFilter(const Tokens& tokens) {
+    std::atomic_store(&tokens_, std::make_shared<const Tokens>(tokens));
+  }
+
+  void flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_.joinable()) return;
+    std::uint64_t ticket = ++requested_;
+    wake_.notify_all();
+    done_.wait(lock, [&] { return flushed_ >= ticket || stop_; });
+  }
+
+ protected:
+  int overflow(int c) {
+    if (c == traits_type::eof()) return traits_type::not_eof(c);
+    char ch = traits_type::to_char_type(c);
+    append(&ch, 1);
+    return c;
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n) {
+    append(s, static_cast<std::size_t>(n));
+    return n;
+  }
+
+ private:
+  /// Size of the pending text over which the thread is woken up.
+  static const std::size_t wakeSize = 1 << 16;
+
+  /// Text of a thread.
+  struct Local {
+    Local() : generation(0) {}
+    /// Text after the last end of line.
+    std::string line;
+    /// Complete lines kept by the filter, reused between the calls.
+    std::string kept;
+    /// Generation of the file line was written for.
+    std::size_t generation;
+  };
+
+  static Local& threadText() {
+    static thread_local Local instance;
+    return instance;
+  }
+
+  void append(const char* s, std::size_t n) {
+    if (!enabled_.load(std::memory_order_relaxed)) return;
+    Local& local = threadText();
+    std::size_t generation = generation_.load(std::memory_order_acquire);
+    if (local.generation != generation) {
+      local.line.clear();
+      local.generation = generation;
+    }
+    local.line.append(s, n);
+    if (std::memchr(s, '\n', n) == NULL) return;
+
+    std::shared_ptr<const Tokens> tokens = std::atomic_load(&tokens_);
+    local.kept.clear();
+    std::size_t begin = 0, end;
+    while ((end = local.line.find('\n', begin)) != std::string::npos) {
+      ++end;
+      if (keep(local.line, begin, end, *tokens))
+        local.kept.append(local.line, begin, end - begin);
+      begin = end;
+    }
+    local.line.erase(0, begin);
+    if (!local.kept.empty()) push(local.kept, generation);
+  }
+
+  static bool keep(const std::string& text, std::size_t begin,
+                   std::size_t end, const Tokens& tokens) {
+    if (tokens.empty()) return true;
+    for (const std::string& token : tokens) {
+      std::size_t pos = text.find(token, begin);
+      if (pos != std::string::npos && pos + token.size() <= end) return true;
+    }
+    return false;
+  }
+
+  void push(const std::string& lines, std::size_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_ || stop_ || generation != generation_) return;
+    pending_ += lines;
+    if (!thread_.joinable())
+      thread_ = std::thread(&TraceBuffer::writeLoop, this);
+    else if (pending_.size() >= wakeSize)
+      wake_.notify_all();
+  }
+
+  void writeLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait_for(lock, std::chrono::milliseconds(100), [this] {
+        return stop_ || requested_ > flushed_ || pending_.size() >= wakeSize;
+      });
+      std::string text;
+      text.swap(pending_);
+      std::uint64_t ticket = requested_;
+      bool enabled = enabled_;
+      std::size_t generation = generation_;
+      std::string filename = filename_;
+      std::size_t maxBytes = maxBytes_, maxFiles = maxFiles_;
+      lock.unlock();
+
+      if (!enabled || generation != openGeneration_) {
+        if (file_.is_open()) file_.close();
+      }
+      if (enabled && !text.empty()) {
+        if (!file_.is_open()) {
+          file_.open(filename.c_str(), std::ios::trunc | std::ios::out);
+          openGeneration_ = generation;
+          size_ = 0;
+        }
+        write(text, filename, maxBytes, maxFiles);
+      }
+      if (file_.is_open()) file_.flush();
+
+      lock.lock();
+      flushed_ = ticket;
+      done_.notify_all();
+      if (stop_ && pending_.empty()) break;
+    }
+    lock.unlock();
+    if (file_.is_open()) file_.close();
+  }
+
+  /// Write the lines of text, rotating the file between two lines.
+  void write(const std::string& text, const std::string& filename,
+             std::size_t maxBytes, std::size_t maxFiles) {
+    std::size_t begin = 0, end;
+    while ((end = text.find('\n', begin)) != std::string::npos) {
+      ++end;
+      if (maxBytes > 0 && size_ > 0 && size_ + end - begin > maxBytes)
+        rotate(filename, maxFiles);
+      file_.write(text.data() + begin,
+                  static_cast<std::streamsize>(end - begin));
+      size_ += end - begin;
+      begin = end;
+    }
+  }
+
+  void rotate(const std::string& filename, std::size_t maxFiles) {
+    file_.close();
+    for (std::size_t k = maxFiles - 1; k > 1; --k) {
+      std::string from = filename + "." + std::to_string(k - 1);
+      std::string to = filename + "." + std::to_string(k);
+      std::rename(from.c_str(), to.c_str());
+    }
+    if (maxFiles > 1)
+      std::rename(filename.c_str(), (filename + ".1").c_str());
+    file_.open(filename.c_str(), std::ios::trunc | std::ios::out);
+    size_ = 0;
+  }
+
+  // Read without lock by the writers, modified under mutex_.
+  std::atomic<bool> enabled_;
+  std::atomic<std::size_t> generation_;
+  // Only accessed through std::atomic_load and std::atomic_store.
+  std::shared_ptr<const Tokens> tokens_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_, done_;
+  std::string pending_;
+  std::string filename_;
+  std::size_t maxBytes_, maxFiles_;
+  bool stop_;
+  std::uint64_t requested_, flushed_;
+  std::thread thread_;
+  std::ostream* stream_;
+
+  // Only used by the thread.
+  std::ofstream file_;
+  std::size_t openGeneration_ = 0;
+  std::size_t size_ = 0;
+};
+
+TraceBuffer& buffer() {
+  static TraceBuffer instance;
+  return instance;
+}
+
+}  // namespace
+
+bool install(std::ostream& stream) {
+  buffer().install(stream);
+  return true;
+}
+
+void enable(const std::string& filename) { buffer().enable(filename); }
+
+void disable() { buffer().disable(); }
+
+void setRotation(std::size_t maxBytes, std::size_t maxFiles) {
+  buffer().setRotation(maxBytes, maxFiles);
+}
+
+void setFilter(const std::vector<std::string>& tokens) {
+  buffer().setFilter(tokens);
+}
+
+void write(const std::string& text) {
+  buffer().sputn(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void flush() { buffer().flush(); }
+
+}  // namespace trace
+}  // namespace python
+}  // namespace dynamicgraph
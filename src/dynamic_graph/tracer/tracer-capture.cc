@@ -0,0 +1,235 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "tracer-capture.hh"
+
+#include <dynamic-graph/factory.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#include "dynamic-graph/python/convert-dg-to-py.hh"
+#include "dynamic-graph/python/gil.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+namespace {
+
+double nan() { return std::numeric_limits<double>::quiet_NaN(); }
+
+std::size_t width(Eigen::Index cols) {
+  return std::size_t(std::max(cols, Eigen::Index(1)));
+}
+
+}  // namespace
+
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(TracerCapture, "TracerCapture");
+
+TracerCapture::TracerCapture(const std::string& name)
+    : Tracer(name), capacity_(1024), count_(0), sequence_(0) {
+  publish();
+}
+
+std::string TracerCapture::getDocString() const {
+  return "Tracer recording its signals into numpy arrays.\n"
+         "\n"
+         "  Add the signals with addSignal, call startCapture (capacity)\n"
+         "  then start. The signals must be of type double, float, int,\n"
+         "  bool or vector, and registered in an entity of the pool.\n";
+}
+
+void TracerCapture::startCapture(std::size_t capacity) {
+  if (capacity == 0)
+    throw std::invalid_argument("the capacity must be positive");
+  closeFiles();
+  {
+    std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+    capacity_ = capacity;
+    publish();
+  }
+  for (const SignalBase<int>* signal : toTrace) openFile(*signal, "");
+  namesSet = true;
+}
+
+void TracerCapture::closeFiles() {
+  std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+  sources_.clear();
+  index_.clear();
+  times_.reset();
+  count_ = 0;
+  sequence_ = 0;
+  publish();
+  // Tracer::closeFiles would take files_mtx again.
+  for (std::ostream* placeholder : files) delete placeholder;
+  files.clear();
+}
+
+void TracerCapture::recordSignal(std::ostream& os,
+                                 const SignalBase<int>& sig) {
+  std::map<const std::ostream*, std::size_t>::const_iterator it =
+      index_.find(&os);
+  const int t = sig.getTime();
+  if (it == index_.end() || timeStart > t) return;
+  const std::size_t k = it->second;
+  Source& source = sources_[k];
+  if (!source.data || !times_) allocate(t);
+
+  const std::size_t n = count_.load(std::memory_order_relaxed);
+  const std::size_t row = n % capacity_;
+  if (k == 0) {
+    sequence_.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    (*times_)[row] = t;
+  }
+  const std::size_t size = width(source.cols);
+  double* values = source.data->data() + row * size;
+  try {
+    source.recorder->read(t, values);
+  } catch (const std::exception&) {
+    std::fill(values, values + size, nan());
+  }
+  if (k + 1 == sources_.size()) {
+    sequence_.store(2 * n + 2, std::memory_order_release);
+    count_.store(n + 1, std::memory_order_release);
+  }
+}
+
+std::size_t TracerCapture::captured() const {
+  return count_.load(std::memory_order_acquire);
+}
+
+bp::list TracerCapture::buffers() const {
+  std::shared_ptr<const Columns> columns = this->columns();
+  bp::list arrays;
+  for (const Column& column : columns->signals)
+    arrays.append(view(column, columns->capacity));
+  return arrays;
+}
+
+bp::object TracerCapture::timeBuffer() const {
+  std::shared_ptr<const Columns> columns = this->columns();
+  return view(columns->time, columns->capacity);
+}
+
+bp::dict TracerCapture::capture() const {
+  std::shared_ptr<const Columns> columns = this->columns();
+  const std::size_t capacity = columns->capacity;
+  Column time;
+  std::vector<Column> copies;
+  {
+    ScopedGILRelease nogil;
+    const std::size_t count = count_.load(std::memory_order_acquire);
+    const std::size_t first = count - std::min(count, capacity);
+    time = copy(columns->time, first, count - first, capacity);
+    for (const Column& column : columns->signals)
+      copies.push_back(copy(column, first, count - first, capacity));
+    // The rows from first on may have been overwritten while copied.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::size_t begun =
+        (sequence_.load(std::memory_order_relaxed) + 1) / 2;
+    if (begun > first + capacity) {
+      const std::size_t rows =
+          std::min(begun - capacity - first, count - first);
+      dropRows(time, rows);
+      for (Column& column : copies) dropRows(column, rows);
+    }
+  }
+  bp::dict result;
+  result["time"] = toArray(time);
+  for (const Column& column : copies) result[column.name] = toArray(column);
+  return result;
+}
+
+void TracerCapture::openFile(const SignalBase<int>& sig, const std::string&) {
+  Source source;
+  source.name = sig.getName();
+  // The tracer only has the signal as constant: reading it may recompute it.
+  source.recorder = makeRecorder(&pool::resolveSignal(pool::signalPath(sig)));
+  // Tracer::record passes the stream of each signal to recordSignal.
+  std::ostream* placeholder = new std::ostream(NULL);
+  std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+  index_[placeholder] = sources_.size();
+  sources_.push_back(std::move(source));
+  files.push_back(placeholder);
+  publish();
+}
+
+void TracerCapture::allocate(int t) {
+  if (!times_) times_ = newColumn(0);
+  for (Source& source : sources_)
+    if (!source.data) {
+      source.cols = source.recorder->columns(t);
+      source.data = newColumn(source.cols);
+    }
+  publish();
+}
+
+void TracerCapture::publish() {
+  std::shared_ptr<Columns> columns = std::make_shared<Columns>();
+  columns->capacity = capacity_;
+  columns->time.name = "time";
+  columns->time.data = times_;
+  for (const Source& source : sources_) {
+    Column column;
+    column.name = source.name;
+    column.cols = source.cols;
+    column.data = source.data;
+    columns->signals.push_back(column);
+  }
+  std::atomic_store(&columns_, std::shared_ptr<const Columns>(columns));
+}
+
+std::shared_ptr<const TracerCapture::Columns> TracerCapture::columns() const {
+  return std::atomic_load(&columns_);
+}
+
+TracerCapture::Data TracerCapture::newColumn(Eigen::Index cols) const {
+  return std::make_shared<std::vector<double> >(capacity_ * width(cols),
+                                                nan());
+}
+
+bp::object TracerCapture::view(const Column& column, std::size_t capacity) {
+  if (!column.data) return bp::object();
+  return convert::viewArray(column.data->data(), Py_ssize_t(capacity),
+                            column.cols, column.data);
+}
+
+TracerCapture::Column TracerCapture::copy(const Column& column,
+                                          std::size_t first, std::size_t n,
+                                          std::size_t capacity) {
+  const std::size_t size = width(column.cols);
+  Column result;
+  result.name = column.name;
+  result.cols = column.cols;
+  result.data = std::make_shared<std::vector<double> >(n * size, nan());
+  if (column.data)
+    for (std::size_t k = 0; k < n; ++k)
+      std::memcpy(result.data->data() + k * size,
+                  column.data->data() + ((first + k) % capacity) * size,
+                  size * sizeof(double));
+  return result;
+}
+
+void TracerCapture::dropRows(Column& column, std::size_t rows) {
+  std::vector<double>& data = *column.data;
+  data.erase(data.begin(), data.begin() + rows * width(column.cols));
+}
+
+bp::object TracerCapture::toArray(const Column& column) {
+  double* data;
+  bp::object array = convert::newArray(
+      column.data->size() / width(column.cols), column.cols, &data);
+  std::copy(column.data->begin(), column.data->end(), data);
+  return array;
+}
+
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,135 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_TRACER_CAPTURE_HH
+#define DYNAMIC_GRAPH_PYTHON_TRACER_CAPTURE_HH
+
+#include <dynamic-graph/tracer.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/recorder.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Tracer copying the values of its signals into columns of doubles in
+/// memory, instead of writing them to files.
+///
+/// Each column holds capacity rows used as a ring buffer: row k of the
+/// capture is stored at row k % capacity. The columns are allocated at the
+/// first record, and can be read from Python as numpy arrays while the
+/// tracer records.
+///
+/// The methods read by Python take no lock, so that they never block
+/// recordSignal, which only runs with the files_mtx of Tracer::record. The
+/// rows are published with a sequence number, 2k + 1 while row k is
+/// written and 2k + 2 once it is complete: capture() copies the rows then
+/// drops those overwritten meanwhile. The columns are published through a
+/// shared pointer when they are allocated, at the first record of their
+/// signal, and when a signal is added.
+class TracerCapture : public Tracer {
+  DYNAMIC_GRAPH_ENTITY_DECL();
+
+ public:
+  explicit TracerCapture(const std::string& name);
+
+  std::string getDocString() const;
+
+  /// Drop the recorded values and record the traced signals in columns of
+  /// capacity rows.
+  void startCapture(std::size_t capacity);
+
+  void closeFiles();
+
+  void recordSignal(std::ostream& os, const SignalBase<int>& sig);
+
+  /// Number of rows recorded since startCapture.
+  std::size_t captured() const;
+
+  std::size_t capacity() const { return columns()->capacity; }
+
+  /// \return a numpy array viewing each column, in the order of addSignal,
+  ///         None for the columns not recorded yet.
+  bp::list buffers() const;
+
+  /// \return a numpy array viewing the times of the rows.
+  bp::object timeBuffer() const;
+
+  /// \return a dictionary of copies of the last recorded rows in
+  ///         chronological order: "time" and the name of each signal.
+  bp::dict capture() const;
+
+ protected:
+  void openFile(const SignalBase<int>& sig, const std::string& filename);
+
+ private:
+  typedef std::shared_ptr<std::vector<double> > Data;
+
+  /// Column of the capture, as read by Python.
+  struct Column {
+    Column() : cols(0) {}
+
+    std::string name;
+    /// 0 for scalars.
+    Eigen::Index cols;
+    /// NULL until the first record of the signal.
+    Data data;
+  };
+
+  /// Columns published to Python.
+  struct Columns {
+    std::size_t capacity;
+    Column time;
+    std::vector<Column> signals;
+  };
+
+  /// Signal recorded into a column.
+  struct Source : Column {
+    std::unique_ptr<Recorder> recorder;
+  };
+
+  /// Allocate the columns of the sources not recorded yet. Called with
+  /// files_mtx.
+  void allocate(int t);
+  /// Publish the columns of the sources. Called with files_mtx.
+  void publish();
+  std::shared_ptr<const Columns> columns() const;
+
+  Data newColumn(Eigen::Index cols) const;
+
+  static bp::object view(const Column& column, std::size_t capacity);
+  /// Copy of n rows of a column starting at row first of the capture.
+  static Column copy(const Column& column, std::size_t first, std::size_t n,
+                     std::size_t capacity);
+  /// Remove the first rows of a copy.
+  static void dropRows(Column& column, std::size_t rows);
+  /// Array of the rows of a copy.
+  static bp::object toArray(const Column& column);
+
+  // Only used with files_mtx.
+  std::size_t capacity_;
+  std::vector<Source> sources_;
+  std::map<const std::ostream*, std::size_t> index_;
+  Data times_;
+
+  /// Number of rows recorded.
+  std::atomic<std::size_t> count_;
+  /// 2k + 1 while row k is written, 2k + 2 once complete.
+  std::atomic<std::size_t> sequence_;
+  /// Only accessed through publish and columns.
+  std::shared_ptr<const Columns> columns_;
+};
+
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_TRACER_CAPTURE_HH
@@ -0,0 +1,226 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "tracer-shared-memory.hh"
+
+#include <dynamic-graph/factory.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "dynamic-graph/python/signal-handle.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+namespace {
+
+std::size_t padded(std::size_t size) { return (size + 7) / 8 * 8; }
+
+}  // namespace
+
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(TracerSharedMemory, "TracerSharedMemory");
+
+TracerSharedMemory::TracerSharedMemory(const std::string& name)
+    : Tracer(name),
+      capacity_(1024),
+      data_(NULL),
+      size_(0),
+      failed_(false),
+      count_(0) {}
+
+TracerSharedMemory::~TracerSharedMemory() { closeSegment(); }
+
+std::string TracerSharedMemory::getDocString() const {
+  return "Tracer publishing its signals into a shared memory segment.\n"
+         "\n"
+         "  Add the signals with addSignal, call openSegment (name,\n"
+         "  capacity) then start. Other processes read the segment with\n"
+         "  dynamic_graph.shm_reader. The signals must be of type double,\n"
+         "  float, int, bool or vector, and registered in an entity of the\n"
+         "  pool.\n";
+}
+
+void TracerSharedMemory::openSegment(const std::string& segment,
+                                     std::size_t capacity) {
+  if (capacity == 0)
+    throw std::invalid_argument("the capacity must be positive");
+  if (segment.size() < 2 || segment[0] != '/' ||
+      segment.find('/', 1) != std::string::npos)
+    throw std::invalid_argument("the name of the segment must be /name");
+#ifdef _WIN32
+  throw std::runtime_error("shared memory is not supported on Windows");
+#endif
+  closeFiles();
+  {
+    std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+    segment_ = segment;
+    capacity_ = capacity;
+  }
+  for (const SignalBase<int>* signal : toTrace) openFile(*signal, "");
+  namesSet = true;
+}
+
+void TracerSharedMemory::closeFiles() {
+  std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+  closeSegment();
+  columns_.clear();
+  index_.clear();
+  // Tracer::closeFiles would take files_mtx again.
+  for (std::ostream* placeholder : files) delete placeholder;
+  files.clear();
+}
+
+void TracerSharedMemory::recordSignal(std::ostream& os,
+                                      const SignalBase<int>& sig) {
+  std::map<const std::ostream*, std::size_t>::const_iterator it =
+      index_.find(&os);
+  const int t = sig.getTime();
+  if (it == index_.end() || timeStart > t) return;
+  const std::size_t k = it->second;
+  if (data_ == NULL) {
+    if (k != 0 || failed_) return;
+    try {
+      createSegment(t);
+    } catch (const std::exception& e) {
+      // Not thrown to the loop of the robot: see the property error.
+      failed_ = true;
+      setError(e.what());
+      return;
+    }
+  }
+  const std::uint64_t n = count_.load(std::memory_order_relaxed);
+  char* slot = data_ + headerSize_ + (n % capacity_) * slotSize_;
+  Sequence* seq = reinterpret_cast<Sequence*>(slot);
+  if (k == 0) {
+    seq->store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const std::int64_t time = t;
+    std::memcpy(slot + 8, &time, sizeof(time));
+  }
+  const Column& column = columns_[k];
+  double* values = reinterpret_cast<double*>(slot + 16) + column.offset;
+  try {
+    column.recorder->read(t, values);
+  } catch (const std::exception&) {
+    std::fill(values, values + column.width,
+              std::numeric_limits<double>::quiet_NaN());
+  }
+  if (k + 1 == columns_.size()) {
+    seq->store(2 * n + 2, std::memory_order_release);
+    count_.store(n + 1, std::memory_order_release);
+    header()->published.store(n + 1, std::memory_order_release);
+  }
+}
+
+std::size_t TracerSharedMemory::published() const {
+  return count_.load(std::memory_order_acquire);
+}
+
+std::string TracerSharedMemory::error() const {
+  std::shared_ptr<const std::string> error = std::atomic_load(&error_);
+  return error ? *error : std::string();
+}
+
+void TracerSharedMemory::openFile(const SignalBase<int>& sig,
+                                  const std::string&) {
+  Column column;
+  column.name = sig.getName();
+  // The tracer only has the signal as constant: reading it may recompute it.
+  column.recorder = makeRecorder(&pool::resolveSignal(pool::signalPath(sig)));
+  // Tracer::record passes the stream of each signal to recordSignal.
+  std::ostream* placeholder = new std::ostream(NULL);
+  std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+  // The layout of the segment has no room for the new signal.
+  closeSegment();
+  index_[placeholder] = columns_.size();
+  columns_.push_back(std::move(column));
+  files.push_back(placeholder);
+}
+
+void TracerSharedMemory::createSegment(int t) {
+#ifndef _WIN32
+  headerSize_ = sizeof(Header);
+  std::size_t doubles = 0;
+  for (Column& column : columns_) {
+    column.cols = column.recorder->columns(t);
+    column.width = std::size_t(std::max(column.cols, Eigen::Index(1)));
+    column.offset = doubles;
+    doubles += column.width;
+    headerSize_ += padded(12 + column.name.size());
+  }
+  slotSize_ = 16 + doubles * sizeof(double);
+  const std::size_t size = headerSize_ + capacity_ * slotSize_;
+
+  // Readers keep the previous segment mapped: it is replaced, not resized.
+  ::shm_unlink(segment_.c_str());
+  int fd = ::shm_open(segment_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) throw std::runtime_error("cannot create " + segment_);
+  void* data =
+      ::ftruncate(fd, off_t(size)) == 0
+          ? ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+          : MAP_FAILED;
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    ::shm_unlink(segment_.c_str());
+    throw std::runtime_error("cannot allocate " + segment_);
+  }
+  data_ = static_cast<char*>(data);
+  size_ = size;
+
+  Header* head = new (data_) Header();
+  for (std::size_t i = 0; i < capacity_; ++i)
+    new (data_ + headerSize_ + i * slotSize_) Sequence(0);
+  head->headerSize = std::uint32_t(headerSize_);
+  head->signals = std::uint32_t(columns_.size());
+  head->capacity = capacity_;
+  head->slotSize = slotSize_;
+  char* descriptor = data_ + sizeof(Header);
+  for (const Column& column : columns_) {
+    const std::uint32_t fields[3] = {std::uint32_t(column.width),
+                                     column.cols > 0 ? 1u : 0u,
+                                     std::uint32_t(column.name.size())};
+    std::memcpy(descriptor, fields, sizeof(fields));
+    std::memcpy(descriptor + 12, column.name.data(), column.name.size());
+    descriptor += padded(12 + column.name.size());
+  }
+  // Readers check the magic number last.
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(head->magic, "DGSHMEM1", 8);
+#endif
+}
+
+void TracerSharedMemory::closeSegment() {
+#ifndef _WIN32
+  if (data_ != NULL) {
+    header()->closed.store(1u, std::memory_order_release);
+    ::munmap(data_, size_);
+    ::shm_unlink(segment_.c_str());
+  }
+#endif
+  data_ = NULL;
+  size_ = 0;
+  count_ = 0;
+  failed_ = false;
+  setError("");
+}
+
+void TracerSharedMemory::setError(const std::string& error) {
+  std::atomic_store(&error_, std::make_shared<const std::string>(error));
+}
+
+}  // namespace python
+}  // namespace dynamicgraph
@@ -0,0 +1,138 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_TRACER_SHARED_MEMORY_HH
+#define DYNAMIC_GRAPH_PYTHON_TRACER_SHARED_MEMORY_HH
+
+#include <dynamic-graph/tracer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dynamic-graph/python/recorder.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Tracer publishing the values of its signals into a POSIX shared memory
+/// segment, read by other processes with dynamic_graph.shm_reader.
+///
+/// The segment starts with a header
+/// - char magic[8] = "DGSHMEM1",
+/// - uint32 header size, a multiple of 8,
+/// - uint32 number of signals,
+/// - uint64 number of slots,
+/// - uint64 size of a slot,
+/// - uint64 number of records published,
+/// - uint32 1 once the segment is closed, uint32 unused,
+/// followed by one descriptor per signal: uint32 number of doubles of the
+/// value, uint32 dimension of the value, 0 for a scalar and 1 for a vector,
+/// uint32 size of the name followed by the name, padded to 8 bytes.
+///
+/// The slots follow the header and are used as a ring buffer: record n is
+/// written to slot n % capacity. A slot holds a uint64 sequence number, an
+/// int64 time and the doubles of the values. The sequence number is 2n + 1
+/// while record n is written and 2n + 2 once it is complete, so that the
+/// readers detect the records written or overwritten while they copy them.
+/// The segment is created at the first record, once the sizes of the values
+/// are known, and created again when a signal is added afterwards: the
+/// readers see the previous one closed.
+///
+/// recordSignal only runs with the files_mtx of Tracer::record, and the
+/// readers, in this process or not, take no lock: the sequence numbers are
+/// the only synchronization between them.
+class TracerSharedMemory : public Tracer {
+  DYNAMIC_GRAPH_ENTITY_DECL();
+
+ public:
+  explicit TracerSharedMemory(const std::string& name);
+
+  ~TracerSharedMemory();
+
+  std::string getDocString() const;
+
+  /// Publish the traced signals into the segment /name of capacity slots,
+  /// replacing the segment of the same name if any.
+  void openSegment(const std::string& segment, std::size_t capacity);
+
+  void closeFiles();
+
+  void recordSignal(std::ostream& os, const SignalBase<int>& sig);
+
+  /// Number of records published since openSegment.
+  std::size_t published() const;
+
+  std::size_t capacity() const { return capacity_; }
+
+  std::string segment() const { return segment_; }
+
+  /// Why the segment could not be created, if so.
+  std::string error() const;
+
+ protected:
+  void openFile(const SignalBase<int>& sig, const std::string& filename);
+
+ private:
+  typedef std::atomic<std::uint64_t> Sequence;
+
+  // The atomics of the segment are shared with the readers.
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+                "the atomics must be lock free");
+  static_assert(sizeof(Sequence) == sizeof(std::uint64_t),
+                "the atomics must have the size of their value");
+
+  struct Header {
+    char magic[8];
+    std::uint32_t headerSize;
+    std::uint32_t signals;
+    std::uint64_t capacity;
+    std::uint64_t slotSize;
+    std::atomic<std::uint64_t> published;
+    std::atomic<std::uint32_t> closed;
+    std::uint32_t unused;
+  };
+
+  struct Column {
+    Column() : cols(0), width(1), offset(0) {}
+
+    std::string name;
+    std::unique_ptr<Recorder> recorder;
+    Eigen::Index cols;
+    std::size_t width;
+    /// Index of the first double of the value in a slot.
+    std::size_t offset;
+  };
+
+  Header* header() { return reinterpret_cast<Header*>(data_); }
+
+  /// Called with files_mtx, as closeSegment.
+  void createSegment(int t);
+  void closeSegment();
+  void setError(const std::string& error);
+
+  // Only used with files_mtx.
+  std::string segment_;
+  std::size_t capacity_;
+  char* data_;
+  std::size_t size_, headerSize_, slotSize_;
+  std::vector<Column> columns_;
+  std::map<const std::ostream*, std::size_t> index_;
+  /// Whether the segment could not be created.
+  bool failed_;
+
+  std::atomic<std::size_t> count_;
+  /// Only accessed through setError and error.
+  std::shared_ptr<const std::string> error_;
+};
+
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_TRACER_SHARED_MEMORY_HH
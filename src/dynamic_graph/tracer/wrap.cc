@@ -1,11 +1,103 @@
 #include <dynamic-graph/tracer.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "dynamic-graph/python/gil.hh"
 #include "dynamic-graph/python/module.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+#include "tracer-capture.hh"
+#include "tracer-shared-memory.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Add the signals matching patterns to a tracer, named "entity-signal" as
+/// by tools.addTrace, and to the after hook of a device if any.
+/// \param after None or an object with a method addSignal (path).
+/// \return the paths of the signals.
+bp::list addSignals(Tracer& tracer, const std::string& entity,
+                    const std::string& signal, bool regex, bp::object after) {
+  std::vector<std::string> paths = pool::matchSignals(entity, signal, regex);
+  bp::list result;
+  for (const std::string& path : paths) {
+    std::string filename = path;
+    std::replace(filename.begin(), filename.end(), '/', '_');
+    filename[path.find('.')] = '-';
+    {
+      ScopedGraphCall graphCall;
+      tracer.addSignalToTrace(pool::resolveSignal(path), filename);
+    }
+    if (!after.is_none()) after.attr("addSignal")(path);
+    result.append(path);
+  }
+  return result;
+}
+
+}  // namespace python
+}  // namespace dynamicgraph
 
 BOOST_PYTHON_MODULE(wrap) {
   using dynamicgraph::Tracer;
+  using dynamicgraph::python::TracerCapture;
+  using dynamicgraph::python::TracerSharedMemory;
 
   bp::import("dynamic_graph");
-  dynamicgraph::python::exposeEntity<Tracer>().def("addSignal",
-                                                   &Tracer::addSignalToTrace);
+  dynamicgraph::python::exposeEntity<Tracer>()
+      .def(
+          "addSignal",
+          +[](Tracer& self, const dynamicgraph::SignalBase<int>& signal,
+              const std::string& filename) {
+            dynamicgraph::python::ScopedGraphCall graphCall;
+            self.addSignalToTrace(signal, filename);
+          },
+          (bp::arg("signal"), bp::arg("filename") = ""))
+      .def("addSignals", &dynamicgraph::python::addSignals,
+           "Add the signals of the pool whose entity and signal names match\n"
+           "glob patterns, or regular expressions if regex is True. If after\n"
+           "is given, such as robot.device.after, they are also added to it\n"
+           "to be recomputed at each step. Return their paths.",
+           (bp::arg("entity"), bp::arg("signal") = "*",
+            bp::arg("regex") = false, bp::arg("after") = bp::object()));
+  dynamicgraph::python::exposeEntity<TracerCapture, bp::bases<Tracer> >()
+      .def(
+          "startCapture",
+          +[](TracerCapture& self, std::size_t capacity) {
+            dynamicgraph::python::ScopedGraphCall graphCall;
+            self.startCapture(capacity);
+          },
+          "Drop the recorded values and allocate columns of capacity rows",
+          bp::arg("capacity"))
+      .add_property("captured", &TracerCapture::captured,
+                    "Number of rows recorded since startCapture")
+      .add_property("capacity", &TracerCapture::capacity,
+                    "Number of rows of the columns")
+      .def("buffers", &TracerCapture::buffers,
+           "Numpy arrays viewing the columns of the signals, used as ring\n"
+           "buffers: row k is stored at row k % capacity.")
+      .def("timeBuffer", &TracerCapture::timeBuffer,
+           "Numpy array viewing the times of the rows")
+      .def("capture", &TracerCapture::capture,
+           "Copy of the last recorded rows, in chronological order, by\n"
+           "signal name, and their times under key 'time'.");
+  dynamicgraph::python::exposeEntity<TracerSharedMemory, bp::bases<Tracer> >()
+      .def(
+          "openSegment",
+          +[](TracerSharedMemory& self, const std::string& segment,
+              std::size_t capacity) {
+            dynamicgraph::python::ScopedGraphCall graphCall;
+            self.openSegment(segment, capacity);
+          },
+          "Publish the signals into the shared memory segment /name of\n"
+          "capacity records, created at the first record.",
+          (bp::arg("segment"), bp::arg("capacity") = 1024))
+      .add_property("published", &TracerSharedMemory::published,
+                    "Number of records published since openSegment")
+      .add_property("capacity", &TracerSharedMemory::capacity,
+                    "Number of records of the segment")
+      .add_property("segment", &TracerSharedMemory::segment,
+                    "Name of the segment")
+      .add_property("error", &TracerSharedMemory::error,
+                    "Why the segment could not be created, if so");
 }
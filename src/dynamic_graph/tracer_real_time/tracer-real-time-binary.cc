@@ -0,0 +1,245 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "tracer-real-time-binary.hh"
+
+#include <dynamic-graph/factory.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "dynamic-graph/python/binary-trace.hh"
+#include "dynamic-graph/python/signal-handle.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(TracerRealTimeBinary,
+                                   "TracerRealTimeBinary");
+
+TracerRealTimeBinary::TracerRealTimeBinary(const std::string& name)
+    : TracerRealTime(name),
+      bufferSize_(1 << 20),
+      period_(0.1),
+      stop_(false),
+      epoch_(0),
+      overruns_(0),
+      flushes_(0),
+      bytes_(0),
+      lastLatency_(0),
+      maxLatency_(0),
+      totalLatency_(0),
+      flusher_(&TracerRealTimeBinary::flushLoop, this) {}
+
+TracerRealTimeBinary::~TracerRealTimeBinary() {
+  {
+    std::lock_guard<std::mutex> lock(flushMutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  flusher_.join();
+  closeFiles();
+}
+
+std::string TracerRealTimeBinary::getDocString() const {
+  return "Real time tracer writing binary files.\n"
+         "\n"
+         "  Create it instead of TracerRealTime to record the values\n"
+         "  without formatting them, and to write the files from a thread.\n"
+         "  The signals must be of type double, float, int, bool or vector,\n"
+         "  and registered in an entity of the pool.\n"
+         "  Load the files with dynamic_graph.binary_trace.load.\n";
+}
+
+void TracerRealTimeBinary::closeFiles() {
+  Channels channels;
+  FileList placeholders;
+  {
+    std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    channels.swap(channels_);
+    index_.clear();
+    // TracerRealTime::closeFiles expects its own streams.
+    placeholders.swap(files);
+  }
+  // The channels are no longer recorded: written without files_mtx.
+  std::lock_guard<std::mutex> flushLock(flushMutex_);
+  for (std::unique_ptr<Channel>& channel : channels) {
+    writeAll(*channel);
+    std::fclose(channel->file);
+  }
+  for (std::ostream* placeholder : placeholders) delete placeholder;
+}
+
+void TracerRealTimeBinary::trace() {
+  bool handedOver = false;
+  while (!handedOver) {
+    handedOver = true;
+    {
+      // Only switches the buffers, while Tracer::record waits.
+      std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+      for (std::unique_ptr<Channel>& channel : channels_)
+        if (channel->used[channel->active] > 0 && !handOver(*channel, false))
+          handedOver = false;
+    }
+    std::unique_lock<std::mutex> lock(flushMutex_);
+    wake_.notify_all();
+    written_.wait(lock, [this] { return stop_ || written(); });
+    if (stop_) break;
+  }
+}
+
+void TracerRealTimeBinary::recordSignal(std::ostream& os,
+                                        const SignalBase<int>& sig) {
+  std::map<const std::ostream*, std::size_t>::const_iterator it =
+      index_.find(&os);
+  const int t = sig.getTime();
+  if (it == index_.end() || timeStart > t) return;
+  Channel& channel = *channels_[it->second];
+  if (channel.stride == 0) {
+    channel.cols = channel.recorder->columns(t);
+    writeHeader(channel);
+  }
+  const unsigned epoch = epoch_.load(std::memory_order_relaxed);
+  if (channel.epoch != epoch && channel.used[channel.active] > 0 &&
+      handOver(channel, false))
+    channel.epoch = epoch;
+  if (channel.used[channel.active] + channel.stride > capacity(channel) &&
+      !handOver(channel, true)) {
+    overruns_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  const int b = channel.active;
+  double* values =
+      binaryTrace::writeRecord(channel.buffers[b].data() + channel.used[b], t);
+  try {
+    channel.recorder->read(t, values);
+  } catch (const std::exception&) {
+    std::fill(values, values + std::max(channel.cols, Eigen::Index(1)),
+              std::numeric_limits<double>::quiet_NaN());
+  }
+  channel.used[b] += channel.stride;
+}
+
+void TracerRealTimeBinary::setBufferSize(std::size_t size) {
+  if (size < 64) throw std::invalid_argument("the buffer size is too small");
+  bufferSize_ = size;
+}
+
+void TracerRealTimeBinary::setFlushPeriod(double period) {
+  if (!(period > 0))
+    throw std::invalid_argument("the flush period must be positive");
+  std::lock_guard<std::mutex> lock(flushMutex_);
+  period_ = period;
+}
+
+bp::dict TracerRealTimeBinary::flushStats() {
+  std::lock_guard<std::mutex> lock(flushMutex_);
+  bp::dict stats;
+  stats["overruns"] = overruns();
+  stats["flushes"] = flushes_;
+  stats["bytes"] = bytes_;
+  stats["last_latency"] = lastLatency_;
+  stats["max_latency"] = maxLatency_;
+  stats["mean_latency"] = flushes_ > 0 ? totalLatency_ / flushes_ : 0.;
+  return stats;
+}
+
+void TracerRealTimeBinary::openFile(const SignalBase<int>& sig,
+                                    const std::string& givenName) {
+  const std::string& name = sig.getName();
+  std::string filename =
+      rootdir + basename +
+      (givenName.empty() ? name.substr(name.rfind("::") + 2) : givenName) +
+      suffix;
+  std::unique_ptr<Channel> channel(new Channel);
+  channel->name = name;
+  // The tracer only has the signal as constant: reading it may recompute it.
+  channel->recorder = makeRecorder(&pool::resolveSignal(pool::signalPath(sig)));
+  channel->buffers[0].resize(bufferSize_);
+  channel->buffers[1].resize(bufferSize_);
+  channel->file = std::fopen(filename.c_str(), "wb");
+  if (channel->file == NULL)
+    throw std::runtime_error("cannot open trace file " + filename);
+  // Tracer::record passes the stream of each signal to recordSignal.
+  std::ostream* placeholder = new std::ostream(NULL);
+  std::lock_guard<decltype(files_mtx)> lock(files_mtx);
+  std::lock_guard<std::mutex> flushLock(flushMutex_);
+  index_[placeholder] = channels_.size();
+  channels_.push_back(std::move(channel));
+  files.push_back(placeholder);
+}
+
+void TracerRealTimeBinary::writeHeader(Channel& channel) {
+  const binaryTrace::Header header =
+      binaryTrace::makeHeader(channel.name, std::size_t(channel.cols));
+  channel.stride = binaryTrace::recordSize(header);
+  std::vector<char>& buffer = channel.buffers[channel.active];
+  if (buffer.size() < header.size + channel.stride)
+    buffer.resize(header.size + channel.stride);
+  binaryTrace::writeHeader(header, buffer.data());
+  channel.used[channel.active] = header.size;
+}
+
+bool TracerRealTimeBinary::handOver(Channel& channel, bool wake) {
+  const int other = 1 - channel.active;
+  if (channel.full[other].load(std::memory_order_acquire)) return false;
+  channel.handedOver[channel.active] = Clock::now();
+  channel.full[channel.active].store(true, std::memory_order_release);
+  channel.active = other;
+  if (wake) wake_.notify_one();
+  return true;
+}
+
+void TracerRealTimeBinary::writeFull(Channel& channel, int b) {
+  std::fwrite(channel.buffers[b].data(), 1, channel.used[b], channel.file);
+  std::fflush(channel.file);
+  bytes_ += channel.used[b];
+  channel.used[b] = 0;
+  lastLatency_ =
+      std::chrono::duration<double>(Clock::now() - channel.handedOver[b])
+          .count();
+  maxLatency_ = std::max(maxLatency_, lastLatency_);
+  totalLatency_ += lastLatency_;
+  ++flushes_;
+  channel.full[b].store(false, std::memory_order_release);
+}
+
+void TracerRealTimeBinary::writeAll(Channel& channel) {
+  const int other = 1 - channel.active;
+  if (channel.full[other].load(std::memory_order_acquire))
+    writeFull(channel, other);
+  std::vector<char>& buffer = channel.buffers[channel.active];
+  std::fwrite(buffer.data(), 1, channel.used[channel.active], channel.file);
+  bytes_ += channel.used[channel.active];
+  channel.used[channel.active] = 0;
+}
+
+bool TracerRealTimeBinary::written() const {
+  for (const std::unique_ptr<Channel>& channel : channels_)
+    if (channel->full[0].load(std::memory_order_acquire) ||
+        channel->full[1].load(std::memory_order_acquire))
+      return false;
+  return true;
+}
+
+void TracerRealTimeBinary::flushLoop() {
+  std::unique_lock<std::mutex> lock(flushMutex_);
+  while (!stop_) {
+    wake_.wait_for(lock, std::chrono::duration<double>(period_));
+    epoch_.fetch_add(1, std::memory_order_relaxed);
+    for (std::unique_ptr<Channel>& channel : channels_)
+      for (int b = 0; b < 2; ++b)
+        if (channel->full[b].load(std::memory_order_acquire))
+          writeFull(*channel, b);
+    written_.notify_all();
+  }
+  written_.notify_all();
+}
+
+}  // namespace python
+}  // namespace dynamicgraph
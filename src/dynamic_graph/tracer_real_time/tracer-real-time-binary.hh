@@ -0,0 +1,164 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#ifndef DYNAMIC_GRAPH_PYTHON_TRACER_REAL_TIME_BINARY_HH
+#define DYNAMIC_GRAPH_PYTHON_TRACER_REAL_TIME_BINARY_HH
+
+#include <dynamic-graph/tracer-real-time.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dynamic-graph/python/dynamic-graph-py.hh"
+#include "dynamic-graph/python/recorder.hh"
+
+namespace dynamicgraph {
+namespace python {
+
+/// Real time tracer writing one binary file per signal.
+///
+/// This is an entity of its own, to be created instead of TracerRealTime:
+/// TracerRealTime, defined by dynamic-graph, still formats the values as
+/// text in record and writes its buffers in the thread calling dump.
+///
+/// The format of the files is described in binary-trace.hh.
+/// dynamic_graph.binary_trace maps them as numpy arrays.
+///
+/// Each signal has two buffers. record fills the active one and hands it
+/// over to a thread writing it to the file when it is full, or at the first
+/// record after each flush period, then goes on with the other one. The
+/// hand over only uses atomic flags: when the thread has not written the
+/// other buffer yet, the record is dropped and counted as an overrun.
+///
+/// Only the thread writes to the files while the tracer records: dump takes
+/// the files_mtx held by Tracer::record to hand the buffers over, and waits
+/// for the thread without it.
+class TracerRealTimeBinary : public TracerRealTime {
+  DYNAMIC_GRAPH_ENTITY_DECL();
+
+ public:
+  explicit TracerRealTimeBinary(const std::string& name);
+
+  ~TracerRealTimeBinary();
+
+  std::string getDocString() const;
+
+  void closeFiles();
+
+  /// Write the buffers of the signals, including the records not handed
+  /// over to the thread yet.
+  void trace();
+
+  void recordSignal(std::ostream& os, const SignalBase<int>& sig);
+
+  std::size_t bufferSize() const { return bufferSize_; }
+  /// Size in bytes of each of the two buffers of the signals opened
+  /// afterwards.
+  void setBufferSize(std::size_t size);
+
+  double flushPeriod() const { return period_; }
+  /// Maximal time in seconds between a record and its hand over to the
+  /// thread, when the tracer records.
+  void setFlushPeriod(double period);
+
+  /// Number of records lost because both buffers of a signal were full.
+  std::size_t overruns() const {
+    return overruns_.load(std::memory_order_relaxed);
+  }
+
+  bp::dict flushStats();
+
+ protected:
+  void openFile(const SignalBase<int>& sig, const std::string& givenName);
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Channel {
+    Channel() : cols(0), stride(0), active(0), epoch(0), file(NULL) {
+      used[0] = used[1] = 0;
+      full[0] = full[1] = false;
+    }
+
+    std::string name;
+    std::unique_ptr<Recorder> recorder;
+    Eigen::Index cols;
+    std::size_t stride;
+    std::vector<char> buffers[2];
+    std::size_t used[2];
+    /// Whether a buffer was handed over to the thread.
+    std::atomic<bool> full[2];
+    Clock::time_point handedOver[2];
+    /// Buffer filled by record.
+    int active;
+    unsigned epoch;
+    std::FILE* file;
+  };
+
+  typedef std::vector<std::unique_ptr<Channel> > Channels;
+
+  static std::size_t capacity(const Channel& channel) {
+    return channel.buffers[channel.active].size();
+  }
+
+  /// Write the header at the beginning of the active buffer, before the
+  /// first record, once the size of the value is known, and set the stride.
+  void writeHeader(Channel& channel);
+
+  /// Hand the active buffer over to the thread and switch to the other one.
+  /// \param wake whether to wake the thread up instead of letting it write
+  ///        the buffer at the end of the period.
+  /// \return false if the thread has not written the other one yet.
+  bool handOver(Channel& channel, bool wake);
+
+  /// Write a buffer handed over to the thread to the file, and not only to
+  /// the buffer of the stream. Called with flushMutex_.
+  void writeFull(Channel& channel, int b);
+
+  /// Write both buffers of a channel no longer recorded, in order. Called
+  /// with flushMutex_.
+  void writeAll(Channel& channel);
+
+  /// Whether the thread wrote all the buffers handed over. Called with
+  /// flushMutex_.
+  bool written() const;
+
+  void flushLoop();
+
+  std::size_t bufferSize_;
+
+  /// Protects channels_ against the thread, and the statistics. Taken after
+  /// files_mtx when both are needed.
+  std::mutex flushMutex_;
+  /// wake_ wakes the thread up, which notifies written_ after each pass.
+  std::condition_variable wake_, written_;
+  double period_;
+  bool stop_;
+  /// Incremented by the thread at each period.
+  std::atomic<unsigned> epoch_;
+  std::atomic<std::size_t> overruns_;
+  std::size_t flushes_, bytes_;
+  double lastLatency_, maxLatency_, totalLatency_;
+
+  /// Modified with files_mtx and flushMutex_.
+  Channels channels_;
+  /// Only used with files_mtx.
+  std::map<const std::ostream*, std::size_t> index_;
+  std::thread flusher_;
+};
+
+}  // namespace python
+}  // namespace dynamicgraph
+
+#endif  // DYNAMIC_GRAPH_PYTHON_TRACER_REAL_TIME_BINARY_HH
@@ -1,11 +1,38 @@
 #include <dynamic-graph/tracer-real-time.h>
 
+#include "dynamic-graph/python/gil.hh"
 #include "dynamic-graph/python/module.hh"
+#include "tracer-real-time-binary.hh"
 
 BOOST_PYTHON_MODULE(wrap) {
   using dynamicgraph::Tracer;
   using dynamicgraph::TracerRealTime;
+  using dynamicgraph::python::TracerRealTimeBinary;
 
   bp::import("dynamic_graph.tracer");
   dynamicgraph::python::exposeEntity<TracerRealTime, bp::bases<Tracer> >();
+  dynamicgraph::python::exposeEntity<TracerRealTimeBinary,
+                                     bp::bases<TracerRealTime> >()
+      .add_property("bufferSize", &TracerRealTimeBinary::bufferSize,
+                    &TracerRealTimeBinary::setBufferSize,
+                    "Size in bytes of each of the two buffers of the signals "
+                    "opened afterwards")
+      .add_property("flushPeriod", &TracerRealTimeBinary::flushPeriod,
+                    &TracerRealTimeBinary::setFlushPeriod,
+                    "Maximal time in seconds between a record and its hand "
+                    "over to the writing thread")
+      .add_property("overruns", &TracerRealTimeBinary::overruns,
+                    "Number of records lost because both buffers of a "
+                    "signal were full")
+      .def("flushStats", &TracerRealTimeBinary::flushStats,
+           "Statistics of the writing thread: overruns, flushes and bytes\n"
+           "written, and last, max and mean latency in seconds between the\n"
+           "hand over of a buffer and its write.")
+      .def(
+          "dump",
+          +[](TracerRealTimeBinary& self) {
+            dynamicgraph::python::ScopedGILRelease nogil;
+            self.trace();
+          },
+          "Write the buffers to the files");
 }
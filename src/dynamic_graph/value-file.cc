@@ -0,0 +1,204 @@
+/*
+ * Copyright CNRS 2026
+ *
+ * This file is part of dynamic-graph-python.
+ */
+
+#include "dynamic-graph/python/value-file.hh"
+
+#include <dynamic-graph/linear-algebra.h>
+#include <dynamic-graph/signal.h>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dynamicgraph {
+namespace python {
+namespace valueFile {
+
+namespace {
+
+enum Kind { DOUBLE, INT, BOOL, VECTOR, MATRIX, TEXT };
+
+template <typename T>
+Signal<T, int>* cast(SignalBase<int>* signal) {
+  return dynamic_cast<Signal<T, int>*>(signal);
+}
+
+template <typename T>
+Signal<T, int>& expect(SignalBase<int>& signal) {
+  Signal<T, int>* s = cast<T>(&signal);
+  if (s == NULL)
+    throw std::invalid_argument("signal " + signal.getName() +
+                                " does not have the type of the value");
+  return *s;
+}
+
+}  // namespace
+
+Writer::Writer(const std::string& filename)
+    : file_(filename.c_str(), std::ios::binary | std::ios::trunc) {
+  if (!file_) throw std::runtime_error("cannot open " + filename);
+}
+
+void Writer::write(const void* data, std::size_t size) {
+  file_.write(static_cast<const char*>(data), std::streamsize(size));
+  static const char zeros[8] = {};
+  if (size % 8 != 0) file_.write(zeros, std::streamsize(8 - size % 8));
+}
+
+MappedFile::MappedFile(const std::string& filename)
+    : filename_(filename), data_(NULL), size_(0), pos_(0) {
+#ifdef _WIN32
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (!file) throw std::runtime_error("cannot open " + filename);
+  buffer_.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("cannot open " + filename);
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("cannot stat " + filename);
+  }
+  size_ = std::size_t(st.st_size);
+  if (size_ > 0) {
+    void* data = ::mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("cannot map " + filename);
+    }
+    data_ = static_cast<const char*>(data);
+  }
+  ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (data_ != NULL) ::munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+const char* MappedFile::read(std::size_t size) {
+  std::size_t padded = (size + 7) / 8 * 8;
+  if (padded < size || size_ - pos_ < padded)
+    throw std::runtime_error(filename_ + " is truncated");
+  const char* p = data_ + pos_;
+  pos_ += padded;
+  return p;
+}
+
+std::uint64_t MappedFile::readSize() {
+  std::uint64_t n;
+  std::memcpy(&n, read(sizeof(n)), sizeof(n));
+  return n;
+}
+
+std::string MappedFile::readString() {
+  std::uint64_t n = readSize();
+  return std::string(read(std::size_t(n)), std::size_t(n));
+}
+
+const double* MappedFile::readDoubles(std::uint64_t n) {
+  if (n > size_ / sizeof(double))
+    throw std::runtime_error(filename_ + " is truncated");
+  return reinterpret_cast<const double*>(read(std::size_t(n) * sizeof(double)));
+}
+
+void writeValue(Writer& writer, SignalBase<int>* signal) {
+  if (Signal<double, int>* s = cast<double>(signal)) {
+    writer.write(std::uint64_t(DOUBLE));
+    double value = s->accessCopy();
+    writer.write(&value, sizeof(value));
+  } else if (Signal<int, int>* s = cast<int>(signal)) {
+    writer.write(std::uint64_t(INT));
+    writer.write(std::uint64_t(std::int64_t(s->accessCopy())));
+  } else if (Signal<bool, int>* s = cast<bool>(signal)) {
+    writer.write(std::uint64_t(BOOL));
+    writer.write(std::uint64_t(s->accessCopy()));
+  } else if (Signal<Vector, int>* s = cast<Vector>(signal)) {
+    const Vector& value = s->accessCopy();
+    writer.write(std::uint64_t(VECTOR));
+    writer.write(std::uint64_t(value.size()));
+    writer.write(value.data(), std::size_t(value.size()) * sizeof(double));
+  } else if (Signal<Matrix, int>* s = cast<Matrix>(signal)) {
+    const Matrix& value = s->accessCopy();
+    writer.write(std::uint64_t(MATRIX));
+    writer.write(std::uint64_t(value.rows()));
+    writer.write(std::uint64_t(value.cols()));
+    writer.write(value.data(), std::size_t(value.size()) * sizeof(double));
+  } else {
+    std::ostringstream oss;
+    signal->get(oss);
+    writer.write(std::uint64_t(TEXT));
+    writer.write(oss.str());
+  }
+}
+
+Setter readValue(MappedFile& file) {
+  std::uint64_t kind = file.readSize();
+  switch (kind) {
+    case DOUBLE: {
+      double value = *file.readDoubles(1);
+      return [value](SignalBase<int>& s) {
+        expect<double>(s).setConstant(value);
+      };
+    }
+    case INT: {
+      int value = int(std::int64_t(file.readSize()));
+      return [value](SignalBase<int>& s) { expect<int>(s).setConstant(value); };
+    }
+    case BOOL: {
+      bool value = file.readSize() != 0;
+      return [value](SignalBase<int>& s) {
+        expect<bool>(s).setConstant(value);
+      };
+    }
+    case VECTOR: {
+      std::uint64_t size = file.readSize();
+      Eigen::Map<const Vector> value(file.readDoubles(size),
+                                     Eigen::Index(size));
+      return [value](SignalBase<int>& s) {
+        expect<Vector>(s).setConstant(value);
+      };
+    }
+    case MATRIX: {
+      std::uint64_t rows = file.readSize();
+      std::uint64_t cols = file.readSize();
+      if (cols != 0 && rows > std::uint64_t(-1) / cols)
+        throw std::runtime_error("corrupted value");
+      Eigen::Map<const Matrix> value(file.readDoubles(rows * cols),
+                                     Eigen::Index(rows), Eigen::Index(cols));
+      return [value](SignalBase<int>& s) {
+        expect<Matrix>(s).setConstant(value);
+      };
+    }
+    case TEXT: {
+      std::string value = file.readString();
+      return [value](SignalBase<int>& s) {
+        std::istringstream iss(value);
+        s.set(iss);
+      };
+    }
+    default:
+      throw std::runtime_error("corrupted value");
+  }
+}
+
+}  // namespace valueFile
+}  // namespace python
+}  // namespace dynamicgraph
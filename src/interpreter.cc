@@ -11,9 +11,12 @@
 
 #include "dynamic-graph/debug.h"
 #include "dynamic-graph/python/interpreter.hh"
+#include "dynamic-graph/python/trace-file.hh"
 
-std::ofstream dg_debugfile("/tmp/dynamic-graph-traces.txt",
-                           std::ios::trunc& std::ios::out);
+// The file is only created at the first trace, see trace-file.hh.
+std::ofstream dg_debugfile;
+static const bool dg_debugfile_installed =
+    dynamicgraph::python::trace::install(dg_debugfile);
 
 // Python initialization commands
 namespace dynamicgraph {
@@ -0,0 +1,89 @@
+// The purpose of this unit test is to check the format of the binary trace
+// files, without the Python modules.
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dynamic-graph/python/binary-trace.hh"
+
+using namespace dynamicgraph::python;
+
+bool check(bool condition, const std::string& what) {
+  if (!condition) std::cerr << "failed: " << what << std::endl;
+  return condition;
+}
+
+// Write a header and records to a file, as TracerRealTimeBinary does, and
+// read them back.
+bool testRoundTrip(const std::string& filename, std::size_t cols) {
+  const binaryTrace::Header header = binaryTrace::makeHeader("e::out", cols);
+  const std::size_t stride = binaryTrace::recordSize(header);
+  const std::size_t width = cols > 0 ? cols : 1;
+  bool ok = check(header.size == 32, "header size padded to 8 bytes") &&
+            check(header.width == width, "width") &&
+            check(header.dimension == (cols > 0 ? 1u : 0u), "dimension") &&
+            check(stride == 8 + 8 * width, "record size");
+
+  const std::size_t records = 3;
+  std::vector<double> storage((header.size + records * stride) / 8);
+  char* data = reinterpret_cast<char*>(storage.data());
+  binaryTrace::writeHeader(header, data);
+  for (std::size_t k = 0; k < records; ++k) {
+    double* values = binaryTrace::writeRecord(
+        data + header.size + k * stride, std::int64_t(k) - 1);
+    for (std::size_t i = 0; i < width; ++i) values[i] = 10. * k + i;
+  }
+  std::FILE* file = std::fopen(filename.c_str(), "wb");
+  std::fwrite(data, 1, storage.size() * 8, file);
+  std::fclose(file);
+
+  std::vector<double> read(storage.size());
+  char* bytes = reinterpret_cast<char*>(read.data());
+  file = std::fopen(filename.c_str(), "rb");
+  const std::size_t size = std::fread(bytes, 1, read.size() * 8, file);
+  std::fclose(file);
+  std::remove(filename.c_str());
+
+  binaryTrace::Header loaded;
+  ok = check(size == storage.size() * 8, "file size") &&
+       check(std::memcmp(bytes, "DGTRACE1", 8) == 0, "magic number") &&
+       check(binaryTrace::readHeader(bytes, size, loaded), "read header") &&
+       check(loaded.size == header.size && loaded.width == header.width &&
+                 loaded.dimension == header.dimension &&
+                 loaded.name == "e::out",
+             "header read back") &&
+       ok;
+  for (std::size_t k = 0; ok && k < records; ++k) {
+    std::int64_t time;
+    const double* values =
+        binaryTrace::readRecord(bytes + loaded.size + k * stride, time);
+    ok = check(time == std::int64_t(k) - 1, "time read back");
+    for (std::size_t i = 0; ok && i < width; ++i)
+      ok = check(values[i] == 10. * k + i, "value read back");
+  }
+  return ok;
+}
+
+bool testInvalidHeader() {
+  const binaryTrace::Header header = binaryTrace::makeHeader("signal", 0);
+  std::vector<char> data(header.size);
+  binaryTrace::writeHeader(header, data.data());
+  binaryTrace::Header loaded;
+  bool ok = check(!binaryTrace::readHeader(data.data(), header.size - 1,
+                                           loaded),
+                  "truncated header rejected");
+  data[0] = 'X';
+  return check(!binaryTrace::readHeader(data.data(), data.size(), loaded),
+               "wrong magic number rejected") &&
+         ok;
+}
+
+int main(int, char**) {
+  const std::string filename = "binary-trace-test.dgtrace";
+  bool ok = testRoundTrip(filename, 0);
+  ok = testRoundTrip(filename, 3) && ok;
+  ok = testInvalidHeader() && ok;
+  return ok ? 0 : 1;
+}
@@ -35,6 +35,12 @@ CustomEntity::CustomEntity(const std::string n)
   this->addCommand("act",
                    makeCommandVoid0(*this, &CustomEntity::act,
                                     docCommandVoid0("act on input signal")));
+  this->addCommand("scale",
+                   makeCommandReturnType1(*this, &CustomEntity::scale,
+                                          "return twice a vector"));
+  this->addCommand("echo",
+                   makeCommandReturnType1(*this, &CustomEntity::echo,
+                                          "return a list of values"));
 }
 
 void CustomEntity::addSignal() {
@@ -72,5 +78,11 @@ double &CustomEntity::update(double &res, const int &inTime) {
 
 void CustomEntity::act() { m_sigdSIN.accessCopy(); }
 
+Vector CustomEntity::scale(const Vector &v) { return 2 * v; }
+
+command::Values CustomEntity::echo(const command::Values &values) {
+  return values;
+}
+
 DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(CustomEntity, "CustomEntity");
 }  // namespace dynamicgraph
@@ -6,8 +6,10 @@
 #define ENABLE_RT_LOG
 
 #include <dynamic-graph/entity.h>
+#include <dynamic-graph/linear-algebra.h>
 #include <dynamic-graph/signal-ptr.h>
 #include <dynamic-graph/signal-time-dependent.h>
+#include <dynamic-graph/value.h>
 
 #include <sstream>
 
@@ -27,5 +29,9 @@ class CustomEntity : public Entity {
   double &update(double &res, const int &inTime);
 
   void act();
+
+  Vector scale(const Vector &v);
+
+  command::Values echo(const command::Values &values);
 };
 }  // namespace dynamicgraph
@@ -1,3 +1,4 @@
+import sys
 import unittest
 
 import dynamic_graph as dg
@@ -13,6 +14,21 @@ did not match C++ signature:
 )
 
 
+def wait_until(condition, timeout):
+    """
+    Wait until condition () is true, for at most timeout seconds.
+    Return whether it is.
+    """
+    import time
+
+    deadline = time.monotonic() + timeout
+    while not condition():
+        if time.monotonic() > deadline:
+            return False
+        time.sleep(1e-3)
+    return True
+
+
 class BindingsTests(unittest.TestCase):
     def test_type_check(self):
         """
@@ -56,6 +72,874 @@ class BindingsTests(unittest.TestCase):
         dg.plug(ent_2.signal("out_double"), ent.signal("in_double"))
         ent.act()
 
+    def test_command_arguments(self):
+        """
+        test that commands check the number of their arguments
+        """
+        ent = CustomEntity("test_command_arguments")
+        with self.assertRaises(IndexError) as cm:
+            ent.act(1)
+        self.assertEqual(
+            str(cm.exception), "Wrong number of arguments: expected 0, got 1"
+        )
+        self.assertIsNone(ent.act())
+
+    def test_command_values(self):
+        """
+        test that the arguments of commands are converted at each call
+        """
+        import numpy as np
+
+        ent = CustomEntity("test_command_values")
+        np.testing.assert_array_equal(ent.scale(np.array([1.0, 2.0])), [2.0, 4.0])
+        np.testing.assert_array_equal(ent.scale(np.arange(6.0)[::2]), [0.0, 4.0, 8.0])
+        other = CustomEntity("test_command_values_other")
+        np.testing.assert_array_equal(other.scale(np.ones(1)), [2.0])
+        # The doubles in the byte order opposite to the one of the host are not
+        # read in place, but swapped.
+        order = ">" if sys.byteorder == "little" else "<"
+        swapped = np.array([1.0, 2.0], dtype=order + "f8")
+        np.testing.assert_array_equal(ent.scale(swapped), [2.0, 4.0])
+        (matrix,) = ent.echo([swapped.reshape(1, 2)])
+        np.testing.assert_array_equal(matrix, [[1.0, 2.0]])
+        with self.assertRaises(IndexError):
+            ent.scale()
+
+    def test_numpy_values(self):
+        """
+        test the conversion of numpy arrays and the inference of the types of
+        lists of values
+        """
+        import numpy as np
+
+        ent = CustomEntity("test_numpy_values")
+        matrix = np.arange(6.0).reshape(2, 3)
+        values = ent.echo(
+            [True, 3, 0.5, "text", np.arange(3.0), matrix, matrix.T, [1, [2.0]]]
+        )
+        self.assertEqual(values[:4], [True, 3, 0.5, "text"])
+        self.assertIs(type(values[0]), bool)
+        self.assertIs(type(values[1]), int)
+        for value, expected in zip(values[4:7], [np.arange(3.0), matrix, matrix.T]):
+            self.assertIsInstance(value, np.ndarray)
+            np.testing.assert_array_equal(value, expected)
+        self.assertEqual(values[7], [1, [2.0]])
+        self.assertEqual(ent.echo((np.int64(2), np.float32(1.5))), [2, 1.5])
+        with self.assertRaises(ValueError):
+            ent.echo([object()])
+        with self.assertRaises(ValueError):
+            ent.echo(1.0)
+
+    def test_lazy_attributes(self):
+        """
+        test that commands and signals are resolved as attributes
+        """
+        ent = CustomEntity("test_lazy_attributes")
+        self.assertEqual(ent.in_double.getName(), ent.signal("in_double").getName())
+        self.assertNotIn("in_double", ent.__dict__)
+        self.assertIn("act", dir(ent))
+        self.assertIn("out_double", dir(ent))
+        with self.assertRaises(AttributeError):
+            ent.no_such_attribute
+        self.assertIs(ent.in_double, ent.in_double)
+        self.assertIs(ent.act, ent.act)
+        # The names resolved are kept by the class, and checked on each entity.
+        names = type(ent).__dict__["_entity_names"]
+        self.assertIn("act", names)
+        self.assertIn("in_double", names)
+        self.assertNotIn("no_such_attribute", names)
+        other = CustomEntity("test_lazy_attributes_other")
+        self.assertEqual(other.act.__doc__, ent.act.__doc__)
+        self.assertIsNot(other.act, ent.act)
+
+    def test_attribute_options(self):
+        """
+        test that the signals of an entity exposed without AddSignals are only
+        bound by add_signals
+        """
+        sig = dg.create_signal_wrapper(
+            "test_attribute_options", "double", lambda t: 0.0
+        )
+        container = dg.wrap.PythonSignalContainer("python_signals")
+        with self.assertRaises(AttributeError):
+            container.test_attribute_options
+        self.assertNotIn("test_attribute_options", dir(container))
+        container.add_signals()
+        self.assertEqual(container.test_attribute_options.getName(), sig.getName())
+
+    def test_bulk_api(self):
+        """
+        test the creation and the plug of several entities in one call
+        """
+        errors = dg.create_entities(
+            [
+                ("CustomEntity", "bulk_1"),
+                ("CustomEntity", "bulk_2"),
+                ("NoSuchClass", "bulk_3"),
+            ]
+        )
+        self.assertEqual([index for index, _ in errors], [2])
+        errors = dg.plug_many(
+            [
+                ("bulk_1.out_double", "bulk_2.in_double"),
+                ("bulk_1.out_double", "bulk_3.in_double"),
+            ]
+        )
+        self.assertEqual([index for index, _ in errors], [1])
+        self.assertTrue(CustomEntity("bulk_2").signal("in_double").isPlugged())
+
+    def test_entity_views(self):
+        """
+        test that the views of the pool follow the creation of entities
+        """
+        names = dg.Entity.entities.keys()
+        self.assertIs(dg.Entity.entities.keys(), names)
+        CustomEntity("test_entity_views")
+        self.assertIn("test_entity_views", dg.Entity.entities.keys())
+        self.assertIn("test_entity_views", dg.get_entity_list())
+        self.assertEqual(len(dg.Entity.entities.values()), len(dg.Entity.entities))
+
+    def test_concurrent_pool_access(self):
+        """
+        test reading the pool from threads while entities are created
+        """
+        import threading
+
+        entities = dg.Entity.entities
+        errors = []
+        done = threading.Event()
+
+        def read():
+            try:
+                while not done.is_set():
+                    for name, entity in entities:
+                        self.assertIn(name, entities)
+                        self.assertEqual(entities[name].name, entity.name)
+                    dg.match_signals("test_concurrent_*")
+            except Exception as e:
+                errors.append(e)
+
+        readers = [threading.Thread(target=read) for _ in range(4)]
+        for reader in readers:
+            reader.start()
+        try:
+            for i in range(50):
+                CustomEntity("test_concurrent_%d" % i)
+        finally:
+            done.set()
+            for reader in readers:
+                reader.join()
+        self.assertEqual(errors, [])
+        self.assertEqual(len(dg.match_signals("test_concurrent_*", "in_double")), 50)
+        # A name already taken is not replaced.
+        entities["test_concurrent_0"] = entities["test_concurrent_1"]
+        self.assertEqual(entities["test_concurrent_0"].name, "test_concurrent_0")
+        self.assertIn("test_concurrent_0", dict(entities.items()))
+        with self.assertRaises(IndexError):
+            entities["test_concurrent_none"]
+
+    def test_class_construction(self):
+        """
+        test that calling the class of an entity creates it by the factory,
+        while the monitor thread reads the pool without the GIL
+        """
+        cls = type(CustomEntity("test_class_0"))
+        ident = dg.watch_signal("test_class_0.out_double", lambda value: None)
+        dg.start_monitor(1e-4)
+        try:
+            entities = [cls("test_class_%d" % i) for i in range(1, 50)]
+        finally:
+            dg.stop_monitor()
+        dg.unwatch_signal(ident)
+        for i, ent in enumerate(entities, 1):
+            self.assertIsInstance(ent, cls)
+            self.assertEqual(dg.Entity.entities["test_class_%d" % i].name, ent.name)
+        self.assertEqual(
+            cls("test_class_1").signal("in_double").getName(),
+            entities[0].signal("in_double").getName(),
+        )
+        with self.assertRaises(ValueError):
+            dg.wrap.PythonSignalContainer("test_class_1")
+        # The objects look their entity up again once the pool changed.
+        dg.notify_pool_changed()
+        self.assertEqual(entities[0].name, "test_class_1")
+        self.assertEqual(
+            entities[0].signal("out_double").name,
+            dg.resolve_signal("test_class_1.out_double").name,
+        )
+
+    def test_signal_handle(self):
+        """
+        test that signal handles are interned and follow the pool
+        """
+        handle = dg.signal_handle("handle_entity.in_double")
+        self.assertIs(dg.signal_handle("handle_entity.in_double"), handle)
+        self.assertFalse(handle.valid)
+        ent = CustomEntity("handle_entity")
+        self.assertTrue(handle.valid)
+        self.assertEqual(handle.signal.getName(), ent.signal("in_double").getName())
+        self.assertEqual(
+            dg.resolve_signal("handle_entity.out_double").getName(),
+            ent.signal("out_double").getName(),
+        )
+        with self.assertRaises(Exception):
+            dg.resolve_signal("handle_entity.no_signal")
+        # A removed signal is no longer resolved.
+        dg.create_signal_wrapper("test_handle_signal", "double", lambda t: 0.0)
+        handle = dg.signal_handle("python_signals.test_handle_signal")
+        self.assertTrue(handle.valid)
+        dg.wrap.PythonSignalContainer("python_signals").rmSignal("test_handle_signal")
+        self.assertFalse(handle.valid)
+        with self.assertRaises(Exception):
+            handle.signal
+        # A signal registered again under the path is found by the handle.
+        sig = dg.create_signal_wrapper("test_handle_signal", "double", lambda t: 1.0)
+        self.assertTrue(handle.valid)
+        sig.recompute(3)
+        self.assertEqual(handle.signal.value, 1.0)
+        container = dg.wrap.PythonSignalContainer("python_signals")
+        self.assertEqual(container.signal("test_handle_signal").value, 1.0)
+        with self.assertRaises(Exception):
+            container.signal("test_handle_none")
+
+    def test_recompute_in_threads(self):
+        """
+        test that signals computed by Python are recomputed from other threads,
+        the bindings releasing the GIL around the C++ computation
+        """
+        import threading
+
+        # Each thread recomputes its own signal, since a signal is not
+        # recomputed at a time earlier than its own.
+        times = []
+        outputs = []
+        for t in range(1, 5):
+            sig = dg.create_signal_wrapper(
+                "test_thread_signal_%d" % t,
+                "double",
+                lambda t: times.append(t) or 2.0 * t,
+            )
+            ent = CustomEntity("test_thread_entity_%d" % t)
+            dg.plug(sig, ent.signal("in_double"))
+            outputs.append(ent.signal("out_double"))
+        threads = [
+            threading.Thread(target=out.recompute, args=(t,))
+            for t, out in enumerate(outputs, 1)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        self.assertEqual(sorted(times), [1, 2, 3, 4])
+        self.assertEqual([out.value for out in outputs], [2.0, 4.0, 6.0, 8.0])
+
+    def test_run(self):
+        """
+        test the stepping of the graph in C++
+        """
+        import numpy as np
+
+        sig = dg.create_signal_wrapper("test_run_signal", "double", lambda t: 0.5 * t)
+        ent = CustomEntity("test_run_entity")
+        dg.plug(sig, ent.signal("in_double"))
+        out = ent.signal("out_double")
+        (values,) = dg.run([out], 10, 5, record=[out])
+        self.assertEqual(values.shape, (5,))
+        np.testing.assert_array_equal(values, 0.5 * np.arange(10, 15))
+        array = np.zeros(3)
+        (result,) = dg.run(["test_run_entity.out_double"], 20, 3, [out], [array])
+        self.assertIs(result, array)
+        np.testing.assert_array_equal(array, [10.0, 10.5, 11.0])
+        # The arrays are checked before the graph is recomputed.
+        with self.assertRaises(ValueError):
+            dg.run([out], 30, 3, [out], [np.zeros(2)])
+        self.assertEqual(out.time, 22)
+        self.assertEqual(len(dg.run([out], 30, 0, record=[out])), 0)
+        with self.assertRaises(ValueError) as cm:
+            dg.run([out], 30, -1)
+        self.assertEqual(str(cm.exception), "n_steps must be non-negative")
+
+    def test_value_during_run(self):
+        """
+        test that reading a value does not wait for the end of a run in
+        another thread
+        """
+        import threading
+        import time
+
+        ent = CustomEntity("test_value_during_run")
+        ent.signal("in_double").value = 1.0
+        out = ent.signal("out_double")
+        other = CustomEntity("test_value_during_run_other").signal("in_double")
+        other.value = 2.0
+        thread = threading.Thread(target=dg.run, args=([out], 1, 200000))
+        thread.start()
+        self.assertTrue(wait_until(lambda: out.time > 1, 10.0))
+        start = time.monotonic()
+        for _ in range(100):
+            self.assertEqual(other.value, 2.0)
+        elapsed = time.monotonic() - start
+        running = thread.is_alive()
+        thread.join()
+        self.assertTrue(running)
+        self.assertLess(elapsed, 1.0)
+        self.assertEqual(out.time, 200000)
+
+    def test_run_threads(self):
+        """
+        test the parallel stepping of independent subgraphs
+        """
+        import numpy as np
+
+        outputs, entities = [], []
+        for i in range(3):
+            sig = dg.create_signal_wrapper(
+                "test_cone_signal_%d" % i, "double", lambda t, i=i: float(i + t)
+            )
+            entities.append(CustomEntity("test_cone_entity_%d" % i))
+            dg.plug(sig, entities[i].signal("in_double"))
+            outputs.append(entities[i].signal("out_double"))
+        # Shares the entity of the first output.
+        outputs.append(entities[0].signal("in_double"))
+        self.assertEqual(dg.disjoint_cones(outputs), [[0, 3], [1], [2]])
+        serial = dg.run(outputs, 0, 4, record=outputs[:3])
+        parallel = dg.run(outputs, 10, 4, record=outputs[:3], threads=3)
+        for i in range(3):
+            np.testing.assert_array_equal(serial[i], i + np.arange(4))
+            np.testing.assert_array_equal(parallel[i], i + np.arange(10, 14))
+
+    def test_run_threads_python(self):
+        """
+        test that the cones with signals computed by Python, which may call the
+        bindings, are recomputed by the calling thread, and that their errors
+        are raised again
+        """
+        import numpy as np
+
+        outputs = []
+        for i in range(3):
+            ent = CustomEntity("test_python_cone_entity_%d" % i)
+            ent.signal("in_double").value = float(i)
+            outputs.append(ent.signal("out_double"))
+        spare = CustomEntity("test_python_cone_spare")
+        spare.signal("in_double").value = 100.0
+        sig = dg.create_signal_wrapper(
+            "test_python_cone_signal",
+            "double",
+            lambda t: spare.signal("in_double").value + t,
+        )
+        ent = CustomEntity("test_python_cone_entity_3")
+        dg.plug(sig, ent.signal("in_double"))
+        outputs.append(ent.signal("out_double"))
+        values = dg.run(outputs, 0, 3, record=outputs, threads=4)
+        for i in range(3):
+            np.testing.assert_array_equal(values[i], [i, i, i])
+        np.testing.assert_array_equal(values[3], [100.0, 101.0, 102.0])
+
+        failing = dg.create_signal_wrapper(
+            "test_python_cone_failing", "double", lambda t: 1.0 / 0
+        )
+        dg.plug(failing, ent.signal("in_double"))
+        with self.assertRaises(ZeroDivisionError):
+            dg.run(outputs, 10, 3, threads=4)
+
+    def test_dependency_graph(self):
+        """
+        test the export of the dependency graph of the pool
+        """
+        first = CustomEntity("test_graph_first")
+        second = CustomEntity("test_graph_second")
+        dg.plug(first.signal("out_double"), second.signal("in_double"))
+        graph = dg.dependency_graph()
+        nodes = list(zip(graph["entity"], graph["signal"]))
+        self.assertEqual(len(graph["indptr"]), len(nodes) + 1)
+        self.assertEqual(len(graph["time"]), len(nodes))
+
+        def deps(entity, signal):
+            i = nodes.index((entity, signal))
+            indices = graph["indices"][graph["indptr"][i] : graph["indptr"][i + 1]]
+            return [nodes[j] for j in indices]
+
+        self.assertEqual(
+            deps("test_graph_second", "in_double"), [("test_graph_first", "out_double")]
+        )
+        self.assertEqual(
+            deps("test_graph_first", "out_double"), [("test_graph_first", "in_double")]
+        )
+        index = nodes.index(("test_graph_first", "in_double"))
+        self.assertEqual(graph["type"][index], "double")
+
+    def test_snapshot(self):
+        """
+        test the save and the restoration of the state of the graph
+        """
+        import os
+        import tempfile
+
+        first = CustomEntity("test_snapshot_first")
+        second = CustomEntity("test_snapshot_second")
+        first.signal("in_double").value = 3.5
+        dg.plug(first.signal("out_double"), second.signal("in_double"))
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "state.bin")
+            dg.save_state(path)
+            first.signal("in_double").value = 1.0
+            second.signal("in_double").unplug()
+            self.assertEqual(dg.load_state(path), [])
+        self.assertEqual(first.signal("in_double").value, 3.5)
+        self.assertTrue(second.signal("in_double").isPlugged())
+        with self.assertRaises(RuntimeError):
+            dg.load_state(__file__)
+
+    def test_input_replay(self):
+        """
+        test the recording of the values set to the signals and their replay
+        """
+        import os
+        import tempfile
+
+        import numpy as np
+
+        ent = CustomEntity("test_input_replay")
+        sin = ent.signal("in_double")
+        sout = ent.signal("out_double")
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "inputs.bin")
+            dg.start_input_recording(path, 100)
+            expected = []
+            for t in range(100, 105):
+                sin.value = float(t * t)
+                sout.recompute(t)
+                expected.append(sout.value)
+            self.assertEqual(dg.stop_input_recording(), 5)
+            sin.value = -1.0
+            # Step the graph again from time 100.
+            sout.time = 99
+            (values,) = dg.replay(path, [sout], 100, 5, [sout])
+            np.testing.assert_array_equal(values, expected)
+            self.assertEqual(sin.value, 104.0 * 104.0)
+            with self.assertRaises(RuntimeError):
+                dg.replay(__file__, [sout], 100, 5)
+
+    def test_binary_log(self):
+        """
+        test the binary output stream of the real time logger and its reader
+        """
+        import os
+        import tempfile
+
+        from dynamic_graph import rt_log
+        from dynamic_graph.entity import VerbosityLevel
+
+        ent = CustomEntity("test_binary_log")
+        ent.setLoggerVerbosityLevel(VerbosityLevel.VERBOSITY_ALL)
+        with tempfile.TemporaryDirectory() as directory:
+            prefix = os.path.join(directory, "log")
+            dg.addLoggerBinaryOutputStream(prefix, 4096)
+            for t in range(10):
+                ent.signal("in_double").value = t
+                ent.signal("out_double").recompute(t)
+            for _ in range(1000):
+                dg.real_time_logger_spin_once()
+            dg.closeLoggerBinaryOutputStream()
+            self.assertGreater(len(rt_log.segments(prefix)), 1)
+            records = list(rt_log.read(prefix))
+            self.assertIn("start update 9", [r.message.strip() for r in records])
+            self.assertEqual([r.index for r in records], list(range(len(records))))
+            self.assertEqual(list(rt_log.read(prefix, since=len(records))), [])
+            updates = list(rt_log.read(prefix, contains="start update"))
+            self.assertEqual(len(updates), 10)
+            self.assertEqual(list(rt_log.read(prefix, since=1, until=3)), records[1:3])
+            # The stream closed is removed from the logger.
+            ent.signal("in_double").value = 10
+            ent.signal("out_double").recompute(10)
+            for _ in range(100):
+                dg.real_time_logger_spin_once()
+            self.assertEqual(len(list(rt_log.read(prefix))), len(records))
+
+    def test_logger_spinner(self):
+        """
+        test the thread flushing the real time logger
+        """
+        from dynamic_graph.entity import VerbosityLevel
+
+        ent = CustomEntity("test_logger_spinner")
+        ent.setLoggerVerbosityLevel(VerbosityLevel.VERBOSITY_ERROR)
+        dg.real_time_logger_start_spinner(batch_size=4, period=1e-3)
+        try:
+            for t in range(10):
+                ent.signal("in_double").value = t
+                ent.signal("out_double").recompute(t)
+        finally:
+            dg.real_time_logger_stop_spinner()
+        stats = dg.real_time_logger_stats()
+        self.assertFalse(stats["running"])
+        self.assertEqual(stats["queue_depth"], 0)
+        self.assertGreaterEqual(stats["flushed"], 10)
+        self.assertGreaterEqual(stats["max_latency"], stats["mean_latency"])
+        with self.assertRaises(ValueError):
+            dg.real_time_logger_start_spinner(batch_size=0)
+
+    def test_logging_bridge(self):
+        """
+        test the forwarding of the real time logger to the logging module
+        """
+        import logging
+
+        from dynamic_graph import logging_bridge
+        from dynamic_graph.entity import VerbosityLevel
+
+        messages = []
+
+        class Handler(logging.Handler):
+            def emit(self, record):
+                messages.append((record.levelno, record.getMessage()))
+
+        logger = logging.getLogger("test_bridge")
+        logger.addHandler(Handler())
+        logger.setLevel(logging.DEBUG)
+        ent = CustomEntity("test_logging_bridge")
+        ent.setLoggerVerbosityLevel(VerbosityLevel.VERBOSITY_ERROR)
+        # The logger does not give the type of the messages: the entity only
+        # logs errors.
+        level = logging_bridge.VERBOSITY_LEVELS[VerbosityLevel.VERBOSITY_ERROR]
+        logging_bridge.enable("test_bridge", batch_size=8, level=level)
+        try:
+            ent.signal("in_double").value = 2
+            ent.signal("out_double").recompute(1)
+            for _ in range(100):
+                dg.real_time_logger_spin_once()
+        finally:
+            logging_bridge.disable()
+        self.assertIn((logging.ERROR, "start update 2"), messages)
+        # The stream closed is removed from the logger.
+        count = len(messages)
+        ent.signal("in_double").value = 3
+        ent.signal("out_double").recompute(2)
+        for _ in range(100):
+            dg.real_time_logger_spin_once()
+        self.assertEqual(len(messages), count)
+
+    def test_trace_file(self):
+        """
+        test that the debug trace file is only created at the first trace,
+        filtered and rotated
+        """
+        import os
+        import tempfile
+
+        with tempfile.TemporaryDirectory() as directory:
+            filename = os.path.join(directory, "traces.txt")
+            dg.enableTrace(True, filename)
+            try:
+                dg.setTraceRotation(64, 3)
+                dg.setTraceFilter(["test_trace_file"])
+                dg.flushTrace()
+                self.assertFalse(os.path.exists(filename))
+                for k in range(20):
+                    dg.writeTrace("test_trace_file %02d\n" % k)
+                    dg.writeTrace("dropped %02d\n" % k)
+                # The end of a line is needed to filter and write it.
+                dg.writeTrace("test_trace_file")
+                dg.flushTrace()
+            finally:
+                dg.setTraceFilter([])
+                dg.setTraceRotation(0)
+                dg.enableTrace(False)
+            # Each line has 19 bytes: 3 lines per file of 64 bytes.
+            lines = []
+            for name in (filename + ".2", filename + ".1", filename):
+                with open(name) as f:
+                    text = f.read()
+                self.assertLessEqual(len(text), 64)
+                lines += text.splitlines()
+            self.assertFalse(os.path.exists(filename + ".3"))
+            self.assertEqual(
+                lines, ["test_trace_file %02d" % k for k in range(12, 20)]
+            )
+
+    def test_tracer_capture(self):
+        """
+        test the recording of a tracer into numpy arrays
+        """
+        import numpy as np
+
+        from dynamic_graph.tracer import TracerCapture
+
+        sig = dg.create_signal_wrapper(
+            "test_capture_signal", "double", lambda t: float(t)
+        )
+        ent = CustomEntity("test_capture_entity")
+        dg.plug(sig, ent.signal("in_double"))
+        out = ent.signal("out_double")
+        tracer = TracerCapture("test_tracer_capture")
+        tracer.addSignal(out)
+        tracer.startCapture(4)
+        tracer.start()
+        for t in range(6):
+            tracer.signal("triger").recompute(t)
+        self.assertEqual(tracer.captured, 6)
+        capture = tracer.capture()
+        np.testing.assert_array_equal(capture["time"], [2, 3, 4, 5])
+        np.testing.assert_array_equal(capture[out.name], [2, 3, 4, 5])
+        (buffer,) = tracer.buffers()
+        np.testing.assert_array_equal(buffer, [4, 5, 2, 3])
+        with self.assertRaises(ValueError):
+            tracer.startCapture(0)
+
+    @unittest.skipUnless(sys.platform.startswith("linux"), "reader on Linux only")
+    def test_tracer_shared_memory(self):
+        """
+        test the publication of signals into shared memory and its reader
+        """
+        import numpy as np
+
+        from dynamic_graph import shm_reader
+        from dynamic_graph.tracer import TracerSharedMemory
+
+        sig = dg.create_signal_wrapper("test_shm_signal", "double", lambda t: 3.0 * t)
+        ent = CustomEntity("test_shm_entity")
+        dg.plug(sig, ent.signal("in_double"))
+        out = ent.signal("out_double")
+        tracer = TracerSharedMemory("test_tracer_shm")
+        tracer.addSignal(out)
+        with self.assertRaises(ValueError):
+            tracer.openSegment("no_slash")
+        tracer.openSegment("/dg_test_tracer_shm", 4)
+        tracer.start()
+        for t in range(6):
+            tracer.signal("triger").recompute(t)
+        self.assertEqual(tracer.published, 6)
+        self.assertEqual(tracer.error, "")
+        with shm_reader.Reader("/dg_test_tracer_shm") as reader:
+            self.assertEqual(reader.signals[0].name, out.name)
+            self.assertEqual(reader.published, 6)
+            self.assertEqual(reader.latest()["time"], 5)
+            self.assertIsNone(reader.read(1))
+            records, index = reader.since(0)
+            self.assertEqual(index, 6)
+            np.testing.assert_array_equal(records["time"], [2, 3, 4, 5])
+            np.testing.assert_array_equal(records[out.name], [6, 9, 12, 15])
+            # A signal added to a published segment creates it again.
+            tracer.addSignal(ent.signal("in_double"))
+            self.assertTrue(reader.closed)
+        tracer.signal("triger").recompute(6)
+        with shm_reader.Reader("/dg_test_tracer_shm") as reader:
+            self.assertEqual(len(reader.signals), 2)
+            self.assertEqual(reader.published, 1)
+            np.testing.assert_array_equal(reader.latest()[out.name], 18)
+            tracer.close()
+            self.assertTrue(reader.closed)
+
+    def test_tracer_binary(self):
+        """
+        test the binary files of TracerRealTimeBinary and their loader
+        """
+        import os
+        import tempfile
+
+        import numpy as np
+
+        from dynamic_graph import binary_trace
+        from dynamic_graph.tracer_real_time import TracerRealTimeBinary
+
+        sig = dg.create_signal_wrapper(
+            "test_binary_signal", "double", lambda t: 2.0 * t
+        )
+        ent = CustomEntity("test_binary_entity")
+        dg.plug(sig, ent.signal("in_double"))
+        tracer = TracerRealTimeBinary("test_tracer_binary")
+        tracer.flushPeriod = 1e-3
+        with tempfile.TemporaryDirectory() as directory:
+            tracer.open(directory + os.sep, "trace_", ".dgtrace")
+            tracer.addSignal(ent.signal("out_double"))
+            tracer.start()
+            # The first record after a period hands the buffer over to the
+            # writing thread.
+            times = iter(range(1 << 20))
+
+            def flushed():
+                tracer.signal("triger").recompute(next(times))
+                return tracer.flushStats()["flushes"] > 0
+
+            self.assertTrue(wait_until(flushed, 5.0))
+            recorded = next(times)
+            filename = os.path.join(directory, "trace_out_double.dgtrace")
+            head = binary_trace.header(filename)
+            self.assertEqual(head.name, ent.signal("out_double").name)
+            records = binary_trace.load(filename)
+            self.assertGreater(len(records), 0)
+            np.testing.assert_array_equal(records["time"], np.arange(len(records)))
+            np.testing.assert_array_equal(records["value"], 2.0 * records["time"])
+            del records
+            tracer.dump()
+            self.assertEqual(len(binary_trace.load(filename)), recorded)
+            tracer.close()
+        stats = tracer.flushStats()
+        self.assertEqual(stats["overruns"], 0)
+        self.assertGreaterEqual(stats["flushes"], 1)
+        self.assertGreaterEqual(stats["max_latency"], stats["mean_latency"])
+
+    def test_add_signals(self):
+        """
+        test the addition of the signals matching patterns to a tracer
+        """
+        from dynamic_graph.tracer import TracerCapture
+
+        class After:
+            def __init__(self):
+                self.paths = []
+
+            def addSignal(self, path):
+                self.paths.append(path)
+
+        for i in range(3):
+            CustomEntity("test_pattern_%d" % i)
+        expected = ["test_pattern_%d.out_double" % i for i in range(3)]
+        self.assertEqual(dg.match_signals("test_pattern_*", "out_*"), expected)
+        self.assertEqual(
+            dg.match_signals(r"test_pattern_[12]", r"in_\w+", regex=True),
+            ["test_pattern_1.in_double", "test_pattern_2.in_double"],
+        )
+        with self.assertRaises(ValueError):
+            dg.match_signals("(", regex=True)
+        tracer = TracerCapture("test_add_signals")
+        after = After()
+        self.assertEqual(
+            tracer.addSignals("test_pattern_*", "out_double", after=after), expected
+        )
+        self.assertEqual(after.paths, expected)
+
+    def test_string_conversions(self):
+        """
+        test the exact conversions between arrays and their text
+        """
+        import numpy as np
+
+        from dynamic_graph import signal_base
+
+        vector = (0.1, 1.0 / 3, -2.0)
+        text = signal_base.tupleToString(vector)
+        self.assertEqual(signal_base.stringToTuple(text), vector)
+        matrix = ((1.0, 0.1), (1e-300, -np.pi))
+        text = signal_base.matrixToString(matrix)
+        self.assertEqual(signal_base.stringToMatrix(text), matrix)
+        self.assertEqual(signal_base.stringToObject(text), matrix)
+        self.assertEqual(signal_base.stringToObject("[2](1, 2.5)\n"), (1.0, 2.5))
+        self.assertEqual(signal_base.stringToObject("3"), 3)
+        self.assertEqual(signal_base.matrixToString(()), "[0,0](())")
+        np.testing.assert_array_equal(
+            dg.string_to_array("[2,3]((1,2,3),(4,5,6))"), np.arange(1, 7).reshape(2, 3)
+        )
+        with self.assertRaises(TypeError):
+            signal_base.stringToTuple("[3](1,2)")
+        with self.assertRaises(ValueError):
+            dg.string_to_array("[2](1,2) trailing")
+        self.assertEqual(signal_base.tupleToString((1.0, 0.1)), "[2](1.0,0.1)")
+        # The numbers are written and read whatever the locale.
+        import locale
+
+        previous = locale.setlocale(locale.LC_NUMERIC)
+        try:
+            locale.setlocale(locale.LC_NUMERIC, "de_DE.UTF-8")
+        except locale.Error:
+            return
+        try:
+            self.assertEqual(signal_base.tupleToString((0.5,)), "[1](0.5)")
+            self.assertEqual(signal_base.stringToTuple("[1](0.5)"), (0.5,))
+        finally:
+            locale.setlocale(locale.LC_NUMERIC, previous)
+
+    def test_monitor(self):
+        """
+        test the notification of the changes of signals
+        """
+        import threading
+
+        ent = CustomEntity("test_monitor")
+        out = ent.signal("out_double")
+        ent.signal("in_double").value = 1.0
+        out.recompute(0)
+        values = []
+        changed = threading.Condition()
+
+        def append(value):
+            with changed:
+                values.append(value)
+                changed.notify_all()
+
+        def polled(count):
+            # Once the thread compared the values count more times, it has
+            # seen the values set before.
+            polls = dg.monitor_stats()["polls"] + count
+            return lambda: dg.monitor_stats()["polls"] >= polls
+
+        ident = dg.watch_signal(out, append, 0.5)
+        dg.start_monitor(1e-3)
+        try:
+            with changed:
+                self.assertTrue(changed.wait_for(lambda: len(values) == 1, 5.0))
+            ent.signal("in_double").value = 1.2
+            out.recompute(1)
+            self.assertTrue(wait_until(polled(2), 5.0))
+            ent.signal("in_double").value = 3.0
+            out.recompute(2)
+            with changed:
+                self.assertTrue(changed.wait_for(lambda: len(values) == 2, 5.0))
+        finally:
+            dg.stop_monitor()
+        dg.unwatch_signal(ident)
+        self.assertEqual(values, [1.0, 3.0])
+        # A signal watched as an object is looked up by its path.
+        sig = dg.create_signal_wrapper("test_monitor_removed", "double", lambda t: 0.0)
+        ident = dg.watch_signal(sig, append)
+        dg.wrap.PythonSignalContainer("python_signals").rmSignal(
+            "test_monitor_removed"
+        )
+        dg.start_monitor(1e-3)
+        try:
+            self.assertTrue(wait_until(polled(2), 5.0))
+        finally:
+            dg.stop_monitor()
+        dg.unwatch_signal(ident)
+        self.assertEqual(values, [1.0, 3.0])
+        stats = dg.monitor_stats()
+        self.assertFalse(stats["running"])
+        self.assertEqual(stats["watched"], 0)
+        self.assertGreater(stats["polls"], 0)
+        with self.assertRaises(ValueError):
+            dg.unwatch_signal(ident)
+
+    def test_aio(self):
+        """
+        test awaiting the time of a signal and a command with asyncio
+        """
+        import asyncio
+
+        from dynamic_graph import aio
+
+        ent = CustomEntity("test_aio")
+        ent.signal("in_double").value = 1.0
+        sout = ent.signal("out_double")
+
+        def step():
+            for t in range(4):
+                sout.recompute(t)
+
+        async def scenario():
+            reached = asyncio.ensure_future(sout.at(3))
+            cancelled = sout.at(100)
+            await asyncio.sleep(0.01)
+            self.assertFalse(reached.done())
+            # The graph is stepped by another thread, as by a robot.
+            await asyncio.get_running_loop().run_in_executor(None, step)
+            await asyncio.wait_for(reached, 1.0)
+            await asyncio.wait_for(sout.at(2), 1.0)
+            cancelled.cancel()
+            self.assertIsNone(await aio.call(ent.act))
+
+        asyncio.run(scenario())
+
 
 if __name__ == "__main__":
     unittest.main()